@@ -0,0 +1,464 @@
+/**
+ * @file pdtguardian.cxx
+ *
+ * pdtguardian owns the IPbus connections to a set of timing boards and
+ * polls their monitoring data, publishing the latest snapshots for local
+ * readers so that the boards see a single poller. Snapshots go to a
+ * shared-memory segment, read with SharedSnapshotReader, and to files,
+ * either as JSON or in the schema binary encoding (see BinaryCodec.hpp).
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/MonitoringCollector.hpp"
+#include "timing/CounterRateEngine.hpp"
+#include "timing/SharedSnapshot.hpp"
+#include "timing/PDIMasterNode.hpp"
+#include "timing/EndpointNode.hpp"
+#include "timing/FMCIONode.hpp"
+#include "timing/TLUIONode.hpp"
+#include "timing/toolbox.hpp"
+#include "timing/timingfirmwareinfo/Nljs.hpp"
+#include "timing/timinghardwareinfo/Nljs.hpp"
+#include "timing/timingfirmwareinfo/Codec.hpp"
+#include "timing/timinghardwareinfo/Codec.hpp"
+
+#include "uhal/ConnectionManager.hpp"
+#include "uhal/log/log.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <syslog.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <stdexcept>
+
+using namespace dunedaq::timing;
+
+namespace {
+std::atomic<bool> g_stop(false);
+
+void stop_handler(int) {
+    g_stop = true;
+}
+} // namespace
+
+int createFile (const std::string& filename, bool truncate) {
+    struct stat lstatinfo;
+    int fildes;
+
+    /*
+     * lstat() the file. If it doesn't exist, create it with O_EXCL.
+     * If it does exist, open it for writing and perform the fstat()
+     * check.
+     */
+    if (::lstat(filename.c_str(), &lstatinfo) < 0) {
+        /*
+         * If lstat() failed for any reason other than "file not
+         * existing", exit.
+         */
+        if (errno != ENOENT) {
+            std::string msg = "Error checking file ";
+            msg += filename;
+            msg += ", ";
+            msg += strerror(errno);
+
+            throw std::runtime_error(msg);
+        }
+
+        /*
+         * The file doesn't exist, so create it with O_EXCL to make
+         * sure an attacker can't slip in a file between the lstat()
+         * and open()
+         */
+        if ((fildes =
+                    ::open(filename.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644)) < 0) {
+            std::string msg = "Could not create file ";
+            msg += filename;
+            msg += ", ";
+            msg += strerror(errno);
+
+            throw std::runtime_error(msg);
+        }
+    } else {
+        struct stat fstatinfo;
+        int flags;
+
+        flags = O_RDWR;
+        if (!truncate)
+            flags |= O_APPEND;
+
+        /*
+         * Open an existing file.
+         */
+        if ((fildes = ::open(filename.c_str(), flags)) < 0) {
+            std::string msg = "Could not open file ";
+            msg += filename;
+            msg += ", ";
+            msg += strerror(errno);
+
+            throw std::runtime_error(msg);
+        }
+
+        /*
+         * fstat() the opened file and check that the file mode bits,
+         * inode, and device match.
+         */
+        if (::fstat(fildes, &fstatinfo) < 0
+                || lstatinfo.st_mode != fstatinfo.st_mode
+                || lstatinfo.st_ino != fstatinfo.st_ino
+                || lstatinfo.st_dev != fstatinfo.st_dev) {
+
+            std::string msg = "File ";
+            msg += filename;
+            msg += "has been changed before it could be opened, ";
+            msg += strerror(errno);
+
+            close(fildes);
+
+            throw std::runtime_error(msg);
+        }
+
+        /*
+         * If the above check was passed, we know that the lstat()
+         * and fstat() were done on the same file. Now we check that
+         * there's only one link, and that it's a normal file (this
+         * isn't strictly necessary because the fstat() vs lstat()
+         * st_mode check would also find this)
+         */
+        if (fstatinfo.st_nlink > 1 || !S_ISREG(lstatinfo.st_mode)) {
+            std::string msg = "File ";
+            msg += filename;
+            msg += "has too many links, or is not a regular file, ";
+            msg += strerror(errno);
+
+            close(fildes);
+
+            throw std::runtime_error(msg);
+        }
+
+        /*
+         * Just return the file descriptor if we _don't_ want the file
+         * truncated.
+         */
+        if (!truncate)
+            return fildes;
+
+        /*
+         * On systems which don't support ftruncate() the best we can
+         * do is to close the file and reopen it in create mode, which
+         * unfortunately leads to a race condition, however "systems
+         * which don't support ftruncate()" is pretty much SCO only,
+         * and if you're using that you deserve what you get.
+         * ("Little sympathy has been extended")
+         */
+        ::ftruncate(fildes, 0);
+    }
+
+    return fildes;
+}
+void daemonize(const std::string & out, const std::string & err) {
+    int lPid;
+
+    lPid = fork();
+
+    /* An error occurred */
+    if (lPid < 0) exit(1); /* fork error */
+    /* Success: Let the parent terminate */
+    if (lPid > 0) exit(0); /* parent exits */
+
+    /* child (daemon) continues */
+    /* obtain a new process group */
+    if ( setsid() < 0 ) {
+        exit(1);
+    } 
+
+    int fdout = -1;
+    try {
+        fdout = createFile(out, false);
+    } catch (std::runtime_error& e) {
+        std::cerr << "Failed to create file " << out << ": " << e.what() << std::endl;
+    }
+
+    int fderr = -1;
+    try {
+        fderr = createFile(err, false);
+    } catch (std::runtime_error& e) {
+        std::cerr << "Failed to create file " << err << ": " << e.what() << std::endl;
+    }
+
+    for ( int i = 0 ; i <= 2 ; i++ ) close(i); /* close all standard file descriptors */
+    /* Close all open file descriptors */
+    // for (int x = sysconf(_SC_OPEN_MAX); x >= 0; x--) {
+        // close (x);
+    // }
+
+    dup2(fdout, 1); /* redirect stdout */
+    dup2(fderr, 2); /* redirect stderr */
+
+    chdir("/tmp"); /* change running directory */
+
+    signal(SIGCHLD, SIG_DFL); /* ignore child */
+    signal(SIGTSTP, SIG_IGN); /* ignore tty signals */
+    signal(SIGTTOU, SIG_IGN);
+    signal(SIGTTIN, SIG_IGN);
+    signal(SIGHUP, SIG_IGN); /* catch hangup signal */
+}
+
+/**
+ * @brief      Write a snapshot next to the previous one and rename it into place,
+ *             so that readers never see a partial file.
+ */
+void publish_to_file(const std::string& directory, const std::string& name, const MonitoringSnapshot& snapshot, bool binary) {
+    const std::string lPath = directory + "/" + name + (binary ? ".bin" : ".json");
+    const std::string lTmpPath = lPath + ".tmp";
+
+    {
+        std::ofstream lFile(lTmpPath, std::ios::trunc | std::ios::binary);
+        lFile << snapshot.payload;
+        if (!lFile) throw std::runtime_error("Could not write " + lTmpPath);
+    }
+    if (std::rename(lTmpPath.c_str(), lPath.c_str()) < 0) {
+        throw std::runtime_error("Could not rename " + lTmpPath + ", " + strerror(errno));
+    }
+}
+
+/**
+ * @brief      Serialise a monitoring record, as JSON or as a hash-prefixed binary record.
+ */
+template<typename T>
+std::string serialise(const T& data, bool binary) {
+    if (binary) return binary_codec::encode_record(data);
+    nlohmann::json lJson = data;
+    return lJson.dump();
+}
+
+/**
+ * @brief      Serialise the status and debug records of an IO board; in binary the two records follow each other.
+ */
+template<typename T, typename U>
+std::string serialise(const T& data, const U& debug_data, bool binary) {
+    if (binary) {
+        std::string lBuffer;
+        binary_codec::Writer lWriter(lBuffer);
+        binary_codec::encode_record(lWriter, data);
+        binary_codec::encode_record(lWriter, debug_data);
+        return lBuffer;
+    }
+    nlohmann::json lJson = data, lDebugJson = debug_data;
+    return nlohmann::json{{"status", lJson}, {"debug", lDebugJson}}.dump();
+}
+
+/**
+ * @brief      Register the collection loops of one board.
+ *
+ *             Master firmware data (partitions, command counters) is collected
+ *             on the fast period, IO board data (PLL, SFP) on the slow one. The
+ *             master flags are also kept in the collector history. The partition,
+ *             command generator, trigger and endpoint counters are sampled on the
+ *             rate period, in one dispatch, and their values go to the history.
+ */
+void add_device_tasks(MonitoringCollector& collector, uhal::HwInterface& hw, std::chrono::milliseconds fast_period, std::chrono::milliseconds slow_period,
+                      std::chrono::milliseconds rate_period, std::chrono::milliseconds rate_window, bool binary) {
+    const std::string lId = hw.id();
+
+    const std::vector<std::string> lNodeIds = hw.getNode().getNodes();
+    auto lFind = [&](const std::string& id) -> const uhal::Node* {
+        return std::find(lNodeIds.begin(), lNodeIds.end(), id) != lNodeIds.end() ? &hw.getNode(id) : nullptr;
+    };
+
+    auto lMaster = dynamic_cast<const PDIMasterNode*>(lFind("master_top"));
+    if (lMaster) {
+        MonitoringHistory& lHistory = collector.get_history();
+        collector.add_task(lId + ".master", lId, fast_period, [lId, lMaster, &lHistory, binary]() {
+            timingfirmwareinfo::TimingPDIMasterMonitorData lData;
+            lMaster->get_info(lData);
+            auto lTime = std::chrono::system_clock::now();
+
+            for (uint32_t i=0; i < lData.command_counters.size(); ++i) {
+                const std::string lPrefix = lId + ".fl_cmd" + std::to_string(i);
+                lHistory.record(lPrefix + ".accepted", lData.command_counters.at(i).accepted, lTime);
+                lHistory.record(lPrefix + ".rejected", lData.command_counters.at(i).rejected, lTime);
+            }
+            for (uint32_t i=0; i < lData.partitions_data.size(); ++i) {
+                const std::string lPrefix = lId + ".partition" + std::to_string(i);
+                const auto& lPartition = lData.partitions_data.at(i);
+                lHistory.record(lPrefix + ".in_run", lPartition.in_run, lTime);
+                lHistory.record(lPrefix + ".buffer_occupancy", lPartition.buffer_occupancy, lTime);
+                lHistory.record(lPrefix + ".buffer_error", lPartition.buffer_error, lTime);
+            }
+
+            return serialise(lData, binary);
+        });
+    }
+
+    auto lRates = std::make_shared<CounterRateEngine>(rate_window);
+    if (lMaster) {
+        for (uint32_t i=0; i < PDIMasterNode::kNumberOfPartitions; ++i) {
+            lRates->add_partition(lId + ".partition" + std::to_string(i), lMaster->get_partition_node(i));
+        }
+        lRates->add_fl_cmd_generator(lId + ".fl_cmd", lMaster->getNode<FLCmdGeneratorNode>("master.scmd_gen"));
+        lRates->add_trigger_receiver(lId + ".trig", lMaster->getNode<TriggerReceiverNode>("trig"));
+    }
+
+    // Endpoints sit at the top of the design
+    bool lEndpoints = false;
+    for (auto& lNodeId : lNodeIds) {
+        if (lNodeId.find('.') != std::string::npos) continue;
+        auto lEndpoint = dynamic_cast<const EndpointNode*>(&hw.getNode(lNodeId));
+        if (!lEndpoint) continue;
+        lRates->add_endpoint(lId + "." + lNodeId, *lEndpoint);
+        lEndpoints = true;
+    }
+
+    if (lRates->get_names().size()) {
+        MonitoringHistory& lHistory = collector.get_history();
+        collector.add_task(lId + ".rates", lId, rate_period, [lRates, &lHistory, binary]() {
+            lRates->sample(&lHistory);
+            timingfirmwareinfo::TimingCounterRatesVector lData;
+            lRates->get_info(lData);
+            return serialise(lData, binary);
+        });
+    }
+
+    auto lFMCIO = dynamic_cast<const FMCIONode*>(lFind("io"));
+    if (lFMCIO) {
+        collector.add_task(lId + ".io", lId, slow_period, [lFMCIO, binary]() {
+            timinghardwareinfo::TimingFMCMonitorData lData;
+            timinghardwareinfo::TimingFMCMonitorDataDebug lDebugData;
+            lFMCIO->get_info(lData);
+            lFMCIO->get_info(lDebugData);
+            return serialise(lData, lDebugData, binary);
+        });
+    }
+
+    auto lTLUIO = dynamic_cast<const TLUIONode*>(lFind("io"));
+    if (lTLUIO) {
+        collector.add_task(lId + ".io", lId, slow_period, [lTLUIO, binary]() {
+            timinghardwareinfo::TimingTLUMonitorData lData;
+            timinghardwareinfo::TimingTLUMonitorDataDebug lDebugData;
+            lTLUIO->get_info(lData);
+            lTLUIO->get_info(lDebugData);
+            return serialise(lData, lDebugData, binary);
+        });
+    }
+
+    if (!lMaster && !lEndpoints && !lFMCIO && !lTLUIO) {
+        TLOG() << "Nothing to monitor on device " << lId;
+    }
+}
+
+/**
+ * @brief      Run the timing monitoring daemon.
+ */
+int main(int argc, char const *argv[]) {
+    namespace po = boost::program_options;
+
+    std::string lConnections;
+    std::vector<std::string> lDevices;
+    std::string lOutputDir;
+    std::string lShmName;
+    std::string lFormat;
+    uint32_t lShmSlotSize;
+    uint32_t lFastPeriod, lSlowPeriod;
+    uint32_t lRatePeriod, lRateWindow;
+
+    po::options_description lOptions("pdtguardian options");
+    lOptions.add_options()
+        ("help,h", "Print this help")
+        ("connections,c", po::value<std::string>(&lConnections)->required(), "uHAL connections file")
+        ("device,d", po::value<std::vector<std::string>>(&lDevices)->required(), "Device to monitor; can be repeated")
+        ("output-dir,o", po::value<std::string>(&lOutputDir)->default_value("/tmp/pdtguardian"), "Directory where snapshots are published")
+        ("shm-name", po::value<std::string>(&lShmName)->default_value("/pdtguardian"), "Shared-memory segment where snapshots are published")
+        ("shm-slot-size", po::value<uint32_t>(&lShmSlotSize)->default_value(65536), "Maximum snapshot size in the shared-memory segment, in bytes")
+        ("fast-period", po::value<uint32_t>(&lFastPeriod)->default_value(100), "Period of the master firmware collection, in ms")
+        ("slow-period", po::value<uint32_t>(&lSlowPeriod)->default_value(10000), "Period of the IO hardware collection, in ms")
+        ("rate-period", po::value<uint32_t>(&lRatePeriod)->default_value(1000), "Period of the counter rate sampling, in ms")
+        ("rate-window", po::value<uint32_t>(&lRateWindow)->default_value(10000), "Window of the counter rates, in ms")
+        ("format", po::value<std::string>(&lFormat)->default_value("json"), "Snapshot encoding: json or binary")
+        ("foreground,f", "Do not daemonise");
+
+    po::variables_map lArgs;
+    try {
+        po::store(po::parse_command_line(argc, argv, lOptions), lArgs);
+        if (lArgs.count("help")) {
+            std::cout << lOptions << std::endl;
+            return 0;
+        }
+        po::notify(lArgs);
+        if (lFormat != "json" && lFormat != "binary") throw po::invalid_option_value(lFormat);
+    } catch (const po::error& e) {
+        std::cerr << e.what() << std::endl << lOptions << std::endl;
+        return 1;
+    }
+
+    std::cout << "PDT Guardian" << std::endl;
+
+    if (::mkdir(lOutputDir.c_str(), 0755) < 0 && errno != EEXIST) {
+        std::cerr << "Could not create " << lOutputDir << ": " << strerror(errno) << std::endl;
+        return 1;
+    }
+
+    // daemonize() moves to /tmp
+    char lResolved[PATH_MAX];
+    if (::realpath(lOutputDir.c_str(), lResolved)) lOutputDir = lResolved;
+    if (::realpath(lConnections.c_str(), lResolved)) lConnections = lResolved;
+
+    if (!lArgs.count("foreground")) {
+        daemonize(lOutputDir + "/pdtguardian.out", lOutputDir + "/pdtguardian.err");
+    }
+
+    signal(SIGTERM, stop_handler);
+    signal(SIGINT, stop_handler);
+
+    uhal::setLogLevelTo(uhal::WarningLevel());
+    uhal::ConnectionManager lCM("file://" + lConnections);
+
+    // The collector must be stopped before the hardware interfaces go away
+    std::vector<uhal::HwInterface> lHardware;
+    for (auto& lDevice : lDevices) lHardware.push_back(lCM.getDevice(lDevice));
+
+    SharedSnapshotWriter lSharedSnapshots(lShmName, 64, lShmSlotSize);
+
+    // Called from the collection threads; the shared-memory writer wants a single writer at a time
+    std::mutex lPublishMutex;
+    const bool lBinary = (lFormat == "binary");
+    MonitoringCollector lCollector([&](const std::string& name, const MonitoringSnapshot& snapshot) {
+        {
+            std::lock_guard<std::mutex> lLock(lPublishMutex);
+            lSharedSnapshots.publish(name, snapshot.payload, snapshot.time_gathered);
+        }
+        publish_to_file(lOutputDir, name, snapshot, lBinary);
+    });
+
+    for (auto& lHw : lHardware) {
+        add_device_tasks(lCollector, lHw, std::chrono::milliseconds(lFastPeriod), std::chrono::milliseconds(lSlowPeriod),
+                         std::chrono::milliseconds(lRatePeriod), std::chrono::milliseconds(lRateWindow), lBinary);
+    }
+
+    lCollector.start();
+    while (!g_stop) std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    lCollector.stop();
+
+    return 0;
+}
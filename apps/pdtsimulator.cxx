@@ -0,0 +1,188 @@
+/**
+ * @file pdtsimulator.cxx
+ *
+ * pdtsimulator serves a SimulatedBoard over IPbus 2.0 UDP, so that the
+ * library, the python bindings and the CLI can be run against a timing
+ * system on any Linux box. The board is described by the address table
+ * of a uHAL connection, SIM_UDP by default, and served on the port of
+ * its URI.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/SimulatedBoard.hpp"
+#include "timing/SimulatedIPbusTarget.hpp"
+#include "timing/FLCmdGeneratorNode.hpp"
+#include "timing/toolbox.hpp"
+
+#include "uhal/ConnectionManager.hpp"
+#include "uhal/log/log.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+using namespace dunedaq::timing;
+
+namespace {
+std::atomic<bool> g_stop(false);
+
+void stop_handler(int) {
+    g_stop = true;
+}
+} // namespace
+
+/**
+ * @brief      Port of an ipbusudp-2.0 URI.
+ */
+uint16_t get_udp_port(const std::string& uri) {
+    const std::string lProtocol = "ipbusudp-2.0://";
+    size_t lColon = uri.rfind(':');
+    if (uri.compare(0, lProtocol.size(), lProtocol) || lColon < lProtocol.size()) {
+        throw std::runtime_error("Not an ipbusudp-2.0 URI: " + uri);
+    }
+    return std::stoul(uri.substr(lColon + 1));
+}
+
+/**
+ * @brief      Program the fake trigger generators from <channel>:<rate> strings.
+ */
+void configure_fake_triggers(SimulatedBoard& board, const std::vector<std::string>& triggers, bool poisson) {
+    for (auto& lTrigger : triggers) {
+        size_t lColon = lTrigger.find(':');
+        if (lColon == std::string::npos) throw std::runtime_error("Fake trigger not in the <channel>:<rate> form: " + lTrigger);
+
+        uint32_t lChannel = std::stoul(lTrigger.substr(0, lColon));
+        FakeTriggerConfig lConfig(std::stod(lTrigger.substr(lColon + 1)));
+        board.enable_fake_trigger(lChannel, lConfig.divisor, lConfig.prescale, poisson);
+        TLOG() << "Fake trigger " << lChannel << " at " << lConfig.actual_rate << " Hz";
+    }
+}
+
+/**
+ * @brief      Run the timing board simulator.
+ */
+int main(int argc, char const *argv[]) {
+    namespace po = boost::program_options;
+
+    std::string lConnections;
+    std::string lDevice;
+    std::string lBind;
+    uint32_t lPort;
+    uint32_t lBufferDepth;
+    uint32_t lRunLatency;
+    uint32_t lEchoDelay;
+    uint32_t lSeed;
+    std::vector<std::string> lFakeTriggers;
+    uint32_t lReportPeriod;
+
+    po::options_description lOptions("pdtsimulator options");
+    lOptions.add_options()
+        ("help,h", "Print this help")
+        ("connections,c", po::value<std::string>(&lConnections)->required(), "uHAL connections file")
+        ("device,d", po::value<std::string>(&lDevice)->default_value("SIM_UDP"), "Device to simulate; its address table describes the board")
+        ("bind", po::value<std::string>(&lBind)->default_value("127.0.0.1"), "Address to listen on")
+        ("port,p", po::value<uint32_t>(&lPort)->default_value(0), "UDP port to listen on; defaults to the port of the device URI")
+        ("buffer-depth", po::value<uint32_t>(&lBufferDepth)->default_value(0x8000), "Depth of the readout buffers, in words")
+        ("run-latency", po::value<uint32_t>(&lRunLatency)->default_value(0), "Delay between a run request and the change of run state, in us")
+        ("echo-delay", po::value<uint32_t>(&lEchoDelay)->default_value(100), "Echo round trip time, in clock ticks")
+        ("seed", po::value<uint32_t>(&lSeed)->default_value(0), "Seed of the poisson trigger generators")
+        ("fake-trigger,t", po::value<std::vector<std::string>>(&lFakeTriggers), "Fake trigger generator to start, as <channel>:<rate in Hz>; can be repeated")
+        ("poisson", "Start the fake trigger generators in poisson mode")
+        ("report-period", po::value<uint32_t>(&lReportPeriod)->default_value(10), "Period of the activity report, in s; 0 disables it");
+
+    po::variables_map lArgs;
+    try {
+        po::store(po::parse_command_line(argc, argv, lOptions), lArgs);
+        if (lArgs.count("help")) {
+            std::cout << lOptions << std::endl;
+            return 0;
+        }
+        po::notify(lArgs);
+    } catch (const po::error& e) {
+        std::cerr << e.what() << std::endl << lOptions << std::endl;
+        return 1;
+    }
+
+    std::cout << "PDT Simulator" << std::endl;
+
+    signal(SIGTERM, stop_handler);
+    signal(SIGINT, stop_handler);
+
+    uhal::setLogLevelTo(uhal::WarningLevel());
+    uhal::ConnectionManager lCM("file://" + lConnections);
+    uhal::HwInterface lHw = lCM.getDevice(lDevice);
+
+    SimulatedBoard lBoard(lHw.getNode(), {lBufferDepth, std::chrono::microseconds(lRunLatency), lEchoDelay, lSeed});
+    SimulatedIPbusTarget lTarget(lBoard);
+
+    try {
+        if (!lPort) lPort = get_udp_port(lHw.uri());
+        configure_fake_triggers(lBoard, lFakeTriggers, lArgs.count("poisson"));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    int lSocket = ::socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in lAddress;
+    memset(&lAddress, 0, sizeof(lAddress));
+    lAddress.sin_family = AF_INET;
+    lAddress.sin_port = htons(lPort);
+    if (lSocket < 0 || ::inet_pton(AF_INET, lBind.c_str(), &lAddress.sin_addr) != 1
+            || ::bind(lSocket, reinterpret_cast<sockaddr*>(&lAddress), sizeof(lAddress)) < 0) {
+        std::cerr << "Could not listen on " << lBind << ":" << lPort << ": " << strerror(errno) << std::endl;
+        return 1;
+    }
+
+    TLOG() << "Simulating " << lDevice << " on " << lBind << ":" << lPort;
+
+    std::vector<uint32_t> lRequest(0x4000);
+    std::vector<uint32_t> lReply;
+    auto lLastReport = std::chrono::steady_clock::now();
+
+    while (!g_stop) {
+        pollfd lPoll = {lSocket, POLLIN, 0};
+        if (::poll(&lPoll, 1, 200) <= 0) {
+            lBoard.advance();
+        } else {
+            sockaddr_in lPeer;
+            socklen_t lPeerSize = sizeof(lPeer);
+            ssize_t lBytes = ::recvfrom(lSocket, lRequest.data(), lRequest.size() * sizeof(uint32_t), 0, reinterpret_cast<sockaddr*>(&lPeer), &lPeerSize);
+
+            if (lBytes > 0) {
+                std::vector<uint32_t> lWords(lRequest.begin(), lRequest.begin() + lBytes / sizeof(uint32_t));
+                if (lTarget.handle(lWords, lReply)) {
+                    ::sendto(lSocket, lReply.data(), lReply.size() * sizeof(uint32_t), 0, reinterpret_cast<sockaddr*>(&lPeer), lPeerSize);
+                }
+            }
+        }
+
+        auto lNow = std::chrono::steady_clock::now();
+        if (lReportPeriod && lNow - lLastReport >= std::chrono::seconds(lReportPeriod)) {
+            TLOG() << "Timestamp " << format_timestamp(lBoard.read_timestamp()) << ", " << lTarget.get_packets() << " packets, "
+                   << lTarget.get_transactions() << " transactions, " << lBoard.get_command_count() << " commands issued";
+            lLastReport = lNow;
+        }
+    }
+
+    ::close(lSocket);
+    return 0;
+}
@@ -0,0 +1,296 @@
+/**
+ * @file BinaryCodec.hpp
+ *
+ * Primitives of the compact binary encoding of the monitoring structures.
+ * The per-record encoders and decoders are generated from the schemas into
+ * timing/<schema>/Codec.hpp.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_BINARYCODEC_HPP_
+#define TIMING_INCLUDE_TIMING_BINARYCODEC_HPP_
+
+// PDT Headers
+#include "TimingIssues.hpp"
+
+// C++ Headers
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+/**
+ * @brief      Fixed-layout binary encoding.
+ *
+ *             Fields are written in schema order with no names or padding:
+ *             numbers as little-endian values of their schema width, booleans
+ *             as one byte, strings and sequences as a 32 bit element count
+ *             followed by the elements. An encoded record starts with the hash
+ *             of its schema, which decoders check before reading anything else.
+ */
+namespace binary_codec {
+
+//-----------------------------------------------------------------------------
+constexpr uint64_t fnv1a(const char* text, uint64_t hash=0xcbf29ce484222325ull) {
+    return *text ? fnv1a(text + 1, (hash ^ static_cast<uint8_t>(*text)) * 0x100000001b3ull) : hash;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+constexpr uint64_t combine(uint64_t hash, uint64_t value) {
+    return (hash ^ value) * 0x100000001b3ull + (hash >> 29);
+}
+//-----------------------------------------------------------------------------
+
+
+class Writer {
+
+public:
+    explicit Writer(std::string& buffer) : m_buffer(buffer) {}
+
+    template<typename T>
+    void put(T value) {
+        static_assert(std::is_integral<T>::value, "Only integers are written directly");
+        char lBytes[sizeof(T)];
+        for (size_t i=0; i < sizeof(T); ++i) lBytes[i] = static_cast<char>(static_cast<uint64_t>(value) >> (8*i));
+        m_buffer.append(lBytes, sizeof(T));
+    }
+
+    void put_bytes(const char* data, size_t size) { m_buffer.append(data, size); }
+
+private:
+    std::string& m_buffer;
+};
+
+
+class Reader {
+
+public:
+    Reader(const char* data, size_t size) : m_data(data), m_size(size), m_position(0) {}
+
+    template<typename T>
+    T get() {
+        static_assert(std::is_integral<T>::value, "Only integers are read directly");
+        const char* lBytes = take(sizeof(T));
+        uint64_t lValue = 0;
+        for (size_t i=0; i < sizeof(T); ++i) lValue |= static_cast<uint64_t>(static_cast<uint8_t>(lBytes[i])) << (8*i);
+        return static_cast<T>(lValue);
+    }
+
+    const char* take(size_t size) {
+        if (size > m_size - m_position) throw BinaryCodecError(ERS_HERE, "truncated buffer");
+        const char* lData = m_data + m_position;
+        m_position += size;
+        return lData;
+    }
+
+    size_t remaining() const { return m_size - m_position; }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_position;
+};
+
+
+// Numbers and booleans
+//-----------------------------------------------------------------------------
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value>::type
+encode(Writer& writer, T value) {
+    writer.put(value);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value>::type
+decode(Reader& reader, T& value) {
+    value = reader.get<T>();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+inline void encode(Writer& writer, bool value) {
+    writer.put<uint8_t>(value);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+inline void decode(Reader& reader, bool& value) {
+    value = reader.get<uint8_t>() != 0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type
+encode(Writer& writer, T value) {
+    using Bits = typename std::conditional<sizeof(T) == 8, uint64_t, uint32_t>::type;
+    Bits lBits;
+    std::memcpy(&lBits, &value, sizeof(T));
+    writer.put(lBits);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type
+decode(Reader& reader, T& value) {
+    using Bits = typename std::conditional<sizeof(T) == 8, uint64_t, uint32_t>::type;
+    Bits lBits = reader.get<Bits>();
+    std::memcpy(&value, &lBits, sizeof(T));
+}
+//-----------------------------------------------------------------------------
+
+
+// Strings
+//-----------------------------------------------------------------------------
+inline void encode(Writer& writer, const std::string& value) {
+    writer.put(static_cast<uint32_t>(value.size()));
+    writer.put_bytes(value.data(), value.size());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+inline void decode(Reader& reader, std::string& value) {
+    uint32_t lSize = reader.get<uint32_t>();
+    value.assign(reader.take(lSize), lSize);
+}
+//-----------------------------------------------------------------------------
+
+
+// Sequences, the element codec is found by argument dependent lookup
+//-----------------------------------------------------------------------------
+template<typename T>
+void encode(Writer& writer, const std::vector<T>& value) {
+    writer.put(static_cast<uint32_t>(value.size()));
+    for (auto& lItem : value) encode(writer, lItem);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void decode(Reader& reader, std::vector<T>& value) {
+    uint32_t lSize = reader.get<uint32_t>();
+    // Every element takes at least one byte, so a corrupt count cannot reserve much
+    if (lSize > reader.remaining()) throw BinaryCodecError(ERS_HERE, "sequence longer than the buffer");
+    value.resize(lSize);
+    for (auto& lItem : value) decode(reader, lItem);
+}
+//-----------------------------------------------------------------------------
+
+
+// Layout hashes, combined by the generated record codecs into their schema hash
+//-----------------------------------------------------------------------------
+template<typename T>
+constexpr typename std::enable_if<std::is_arithmetic<T>::value, uint64_t>::type
+layout_hash(const T*) {
+    return combine(fnv1a(std::is_same<T, bool>::value ? "bool" : std::is_floating_point<T>::value ? "float" : std::is_signed<T>::value ? "int" : "uint"), sizeof(T));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+constexpr uint64_t layout_hash(const std::string*) {
+    return fnv1a("string");
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<typename T>
+constexpr uint64_t layout_hash(const std::vector<T>*) {
+    return combine(fnv1a("sequence"), layout_hash(static_cast<const T*>(nullptr)));
+}
+//-----------------------------------------------------------------------------
+
+
+/**
+ * @brief      Schema hash of a type, which changes with any change to its layout.
+ */
+//-----------------------------------------------------------------------------
+template<typename T>
+constexpr uint64_t schema_hash() {
+    return layout_hash(static_cast<const T*>(nullptr));
+}
+//-----------------------------------------------------------------------------
+
+
+/**
+ * @brief      Append a record, prefixed with its schema hash, to a buffer.
+ */
+//-----------------------------------------------------------------------------
+template<typename T>
+void encode_record(Writer& writer, const T& record) {
+    writer.put(schema_hash<T>());
+    encode(writer, record);
+}
+//-----------------------------------------------------------------------------
+
+
+/**
+ * @brief      Encode a record, prefixed with its schema hash.
+ */
+//-----------------------------------------------------------------------------
+template<typename T>
+std::string encode_record(const T& record) {
+    std::string lBuffer;
+    Writer lWriter(lBuffer);
+    encode_record(lWriter, record);
+    return lBuffer;
+}
+//-----------------------------------------------------------------------------
+
+
+/**
+ * @brief      Take the next record from a buffer, checking its schema hash.
+ */
+//-----------------------------------------------------------------------------
+template<typename T>
+T decode_record(Reader& reader) {
+    uint64_t lHash = reader.get<uint64_t>();
+    if (lHash != schema_hash<T>()) throw BinaryCodecSchemaMismatch(ERS_HERE, schema_hash<T>(), lHash);
+
+    T lRecord;
+    decode(reader, lRecord);
+    return lRecord;
+}
+//-----------------------------------------------------------------------------
+
+
+/**
+ * @brief      Decode a record encoded by encode_record, checking its schema hash.
+ */
+//-----------------------------------------------------------------------------
+template<typename T>
+T decode_record(const std::string& buffer) {
+    Reader lReader(buffer.data(), buffer.size());
+
+    T lRecord = decode_record<T>(lReader);
+    if (lReader.remaining()) throw BinaryCodecError(ERS_HERE, "trailing bytes after record");
+    return lRecord;
+}
+//-----------------------------------------------------------------------------
+
+} // namespace binary_codec
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_BINARYCODEC_HPP_
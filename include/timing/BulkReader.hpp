@@ -0,0 +1,122 @@
+/**
+ * @file BulkReader.hpp
+ *
+ * BulkReader collects the registers of many nodes, possibly on many
+ * boards, with one dispatch per board.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_BULKREADER_HPP_
+#define TIMING_INCLUDE_TIMING_BULKREADER_HPP_
+
+// PDT Headers
+#include "timing/EndpointNode.hpp"
+
+// uHal Headers
+#include "uhal/Node.hpp"
+
+// C++ Headers
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+struct EndpointSnapshot {
+    uint32_t state;
+    uint32_t partition;
+    uint32_t address;
+    uint64_t timestamp;
+    uint32_t event_counter;
+    uint32_t buffer_count;
+    bool buffer_error;
+    std::map<std::string, uint32_t> controls;
+    std::map<std::string, uint32_t> status;
+    std::vector<uint32_t> counters;
+};
+
+struct BulkSnapshot {
+    std::map<std::string, uint32_t> registers;              ///< Single registers, and register sets as <name>.<sub node>
+    std::map<std::string, std::vector<uint32_t>> blocks;
+    std::map<std::string, EndpointSnapshot> endpoints;
+    uint32_t dispatches;
+    std::chrono::system_clock::time_point time;
+};
+
+/**
+ * @brief      Snapshot of a fixed set of registers, read in bulk.
+ *
+ *             Reads are registered once, then every call to read() queues them
+ *             all and dispatches once per board. Nodes must outlive the reader.
+ */
+class BulkReader {
+
+public:
+    BulkReader();
+    virtual ~BulkReader();
+
+    /**
+     * @brief      Register a single register.
+     */
+    void add_register(const std::string& name, const uhal::Node& node);
+
+    /**
+     * @brief      Register all the sub nodes of a node, as TimingNode::read_sub_nodes.
+     */
+    void add_registers(const std::string& name, const uhal::Node& node);
+
+    /**
+     * @brief      Register a block read; the size defaults to the node size.
+     */
+    void add_block(const std::string& name, const uhal::Node& node, uint32_t size=0);
+
+    /**
+     * @brief      Register the summary, state and command counters of an endpoint.
+     */
+    void add_endpoint(const std::string& name, const EndpointNode& endpoint);
+
+    /**
+     * @brief      Read all the registered nodes.
+     */
+    BulkSnapshot read() const;
+
+    /**
+     * @brief      Number of words read by each call to read().
+     */
+    uint32_t get_word_count() const;
+
+private:
+    struct RegisterRead {
+        std::string name;
+        const uhal::Node* node;
+    };
+
+    struct BlockRead {
+        std::string name;
+        const uhal::Node* node;
+        uint32_t size;
+    };
+
+    struct EndpointRead {
+        std::string name;
+        const EndpointNode* endpoint;
+        std::vector<std::string> controls;
+        std::vector<std::string> status;
+        uint32_t number_of_counters;
+    };
+
+    std::vector<RegisterRead> m_registers;
+    std::vector<BlockRead> m_blocks;
+    std::vector<EndpointRead> m_endpoints;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_BULKREADER_HPP_
@@ -39,6 +39,11 @@ public:
      */
     std::string get_status(bool print_out=false) const override;
 
+    /**
+     * @brief     Report the CRT endpoint status to a sink.
+     */
+    void report_status(StatusSink& sink) const override;
+
     /**
      * @brief      Enable the crt endpoint
      *
@@ -0,0 +1,131 @@
+/**
+ * @file CounterRateEngine.hpp
+ *
+ * CounterRateEngine samples blocks of command counters and derives
+ * their rates over a sliding window.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_COUNTERRATEENGINE_HPP_
+#define TIMING_INCLUDE_TIMING_COUNTERRATEENGINE_HPP_
+
+// PDT Headers
+#include "timing/EndpointNode.hpp"
+#include "timing/FLCmdGeneratorNode.hpp"
+#include "timing/MonitoringHistory.hpp"
+#include "timing/PartitionNode.hpp"
+#include "timing/TriggerReceiverNode.hpp"
+#include "timing/timingfirmwareinfo/Structs.hpp"
+
+// uHal Headers
+#include "uhal/Node.hpp"
+
+// C++ Headers
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+/**
+ * @brief      Rates of the 32 bit counters of a set of boards.
+ *
+ *             Each call to sample() reads every registered counter block, with
+ *             a single dispatch per board. Counter values are accumulated into
+ *             64 bit totals by counter_increase: a drop is a wraparound only if it
+ *             fits the time between two samples, otherwise the counter was reset
+ *             and only its new value is counted. Rates are averaged over the
+ *             samples taken within the window; the sampling cadence is up to the
+ *             caller, typically a MonitoringCollector task.
+ */
+class CounterRateEngine {
+
+public:
+    explicit CounterRateEngine(std::chrono::milliseconds window=std::chrono::seconds(10));
+    virtual ~CounterRateEngine();
+
+    /**
+     * @brief      Register a block of counters.
+     *
+     * @param[in]  name      Block name
+     * @param[in]  counters  Counter block node
+     * @param[in]  labels    Name of each counter; the block size defaults to the node size
+     */
+    void add_counters(const std::string& name, const uhal::Node& counters, const std::vector<std::string>& labels={});
+
+    /**
+     * @brief      Register the accepted and rejected command counters of a partition.
+     */
+    void add_partition(const std::string& name, const PartitionNode& partition);
+
+    /**
+     * @brief      Register the accepted and rejected counters of a fixed length command generator.
+     */
+    void add_fl_cmd_generator(const std::string& name, const FLCmdGeneratorNode& generator);
+
+    /**
+     * @brief      Register the trigger counters of a trigger receiver.
+     */
+    void add_trigger_receiver(const std::string& name, const TriggerReceiverNode& receiver);
+
+    /**
+     * @brief      Register the received command counters of an endpoint.
+     */
+    void add_endpoint(const std::string& name, const EndpointNode& endpoint);
+
+    /**
+     * @brief      Read all counter blocks and update the rates.
+     *
+     * @param      history  If given, the counter values are also recorded there, as series <block name>.<index>
+     */
+    void sample(MonitoringHistory* history=nullptr);
+
+    /**
+     * @brief      Current rates of all counter blocks.
+     */
+    void get_info(timingfirmwareinfo::TimingCounterRatesVector& mon_data) const;
+
+    /**
+     * @brief      Current rates of one counter block.
+     */
+    timingfirmwareinfo::TimingCounterRates get_rates(const std::string& name) const;
+
+    /**
+     * @brief      Names of the registered counter blocks.
+     */
+    std::vector<std::string> get_names() const;
+
+private:
+    struct CounterSample {
+        std::chrono::steady_clock::time_point time;
+        std::vector<uint64_t> totals;
+    };
+
+    struct CounterBlock {
+        std::string name;
+        const uhal::Node* node;
+        std::vector<std::string> labels;
+        std::vector<uint32_t> last_values;
+        std::deque<CounterSample> samples;
+    };
+
+    void update(CounterBlock& block, const std::vector<uint32_t>& values, std::chrono::steady_clock::time_point time) const;
+    timingfirmwareinfo::TimingCounterRates compute_rates(const CounterBlock& block) const;
+
+    const std::chrono::milliseconds m_window;
+
+    mutable std::mutex m_blocks_mutex;
+    std::vector<CounterBlock> m_blocks;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_COUNTERRATEENGINE_HPP_
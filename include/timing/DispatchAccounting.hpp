@@ -0,0 +1,88 @@
+/**
+ * @file DispatchAccounting.hpp
+ *
+ * Accounting of the IPbus dispatches issued by the high level operations
+ * of the library.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_DISPATCHACCOUNTING_HPP_
+#define TIMING_INCLUDE_TIMING_DISPATCHACCOUNTING_HPP_
+
+// uHal Headers
+#include "uhal/Node.hpp"
+
+// C++ Headers
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace dunedaq {
+namespace timing {
+
+struct DispatchStats {
+    uint64_t calls;
+    uint64_t dispatches;
+    uint64_t max_dispatches;      ///< Most dispatches issued by a single call
+    std::chrono::nanoseconds time;
+};
+
+/**
+ * @brief      Accounts the dispatches issued while it is alive to a key, usually the function name.
+ *
+ *             Scopes nest: a dispatch is accounted to every scope open on the
+ *             calling thread, so the stats of an operation include those of the
+ *             operations it calls. Only dispatches issued through
+ *             counted_dispatch are seen.
+ */
+class DispatchScope {
+
+public:
+    explicit DispatchScope(const std::string& key);
+    virtual ~DispatchScope();
+
+    DispatchScope(const DispatchScope&) = delete;
+    DispatchScope& operator=(const DispatchScope&) = delete;
+
+    /**
+     * @brief      Dispatches issued so far within this scope.
+     */
+    uint64_t get_dispatches() const { return m_dispatches; }
+
+private:
+    friend void counted_dispatch(uhal::ClientInterface& client);
+
+    const std::string m_key;
+    const std::chrono::steady_clock::time_point m_start;
+    uint64_t m_dispatches;
+    DispatchScope* m_parent;
+};
+
+/**
+ * @brief      Dispatch the queued transactions of a client, accounting the dispatch to the open scopes.
+ */
+void counted_dispatch(uhal::ClientInterface& client);
+
+/**
+ * @brief      Stats of the closed scopes, by key.
+ */
+std::map<std::string, DispatchStats> get_dispatch_stats();
+
+/**
+ * @brief      Stats of the closed scopes of one key; all zero if none was closed.
+ */
+DispatchStats get_dispatch_stats(const std::string& key);
+
+/**
+ * @brief      Forget the stats of all scopes.
+ */
+void reset_dispatch_stats();
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_DISPATCHACCOUNTING_HPP_
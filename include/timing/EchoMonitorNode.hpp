@@ -19,6 +19,7 @@
 #include "uhal/DerivedNode.hpp"
 
 #include <string>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
@@ -39,6 +40,23 @@ public:
      */
     uint64_t send_echo_and_measure_delay(int64_t timeout=500) const;
 
+    /**
+     * @brief      Send a series of echoes back to back and collect the round-trip times
+     *
+     * @param[in]  number_of_echoes  Number of echoes to send
+     * @param[in]  timeout           Per-echo timeout, in milliseconds
+     */
+    std::vector<uint64_t> send_echoes_and_measure_delays(uint32_t number_of_echoes, int64_t timeout=500) const;
+
+    /**
+     * @brief      Measure the round-trip time statistics over a series of echoes
+     *
+     * @param[in]  number_of_echoes  Number of echoes to send
+     * @param[in]  max_spread        Tolerated round-trip time spread, in clock ticks
+     * @param[in]  timeout           Per-echo timeout, in milliseconds
+     */
+    RTTStatistics measure_delay_statistics(uint32_t number_of_echoes, uint64_t max_spread=2, int64_t timeout=500) const;
+
     /**
      * @brief     Get status string, optionally print.
      */
@@ -24,6 +24,7 @@
 // C++ Headers
 #include <chrono>
 #include <string>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
@@ -42,6 +43,11 @@ public:
      */
     std::string get_status(bool print_out=false) const override;
 
+    /**
+     * @brief     Report the endpoint status to a sink.
+     */
+    void report_status(StatusSink& sink) const override;
+
     /**
      * @brief      Enable the endpoint
      *
@@ -105,6 +111,11 @@ public:
      */
     uint32_t read_version() const;
 
+    /**
+     * @brief      Read the counters of received commands, one per command type.
+     */
+    std::vector<uint32_t> read_command_counters() const;
+
     /**
      * @brief     Collect monitoring information for timing endpoint
      *
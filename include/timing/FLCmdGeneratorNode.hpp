@@ -21,6 +21,7 @@
 #include "uhal/DerivedNode.hpp"
 
 #include <string>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
@@ -71,6 +72,9 @@ struct FakeTriggerConfig {
 class FLCmdGeneratorNode : public TimingNode {
     UHAL_DERIVEDNODE(FLCmdGeneratorNode)
 public:
+    static const uint32_t kMinCommandSpacing;        ///< Closest spacing of two forced commands the firmware accepts, in clock ticks
+    static const uint32_t kMaxCommandsPerDispatch;
+
     explicit FLCmdGeneratorNode(const uhal::Node& node);
     virtual ~FLCmdGeneratorNode();
 
@@ -80,9 +84,19 @@ public:
     std::string get_status(bool print_out=false) const override;
     
     /**
-     * @brief     Send a fixed length command
+     * @brief     Send a burst of fixed length commands
+     *
+     *            The force toggles, together with a timestamp read after each of
+     *            them, are queued in chunks of up to kMaxCommandsPerDispatch
+     *            commands, one dispatch per chunk. Commands are kept at least
+     *            kMinCommandSpacing apart by padding reads, sized from the bus
+     *            speed measured on the timestamps of the previous chunk. The
+     *            channel accept/reject counters are read around each chunk;
+     *            FLCommandsRejected is thrown as soon as a command is not accepted.
+     *
+     * @return     Timestamp captured alongside each command
      */
-    void send_fl_cmd(uint32_t command, uint32_t channel, const TimestampGeneratorNode& timestamp_gen_node) const;
+    std::vector<uint64_t> send_fl_cmd(uint32_t command, uint32_t channel, const TimestampGeneratorNode& timestamp_gen_node, uint32_t number_of_commands=1) const;
 
     /**
      * @brief     Configure fake trigger
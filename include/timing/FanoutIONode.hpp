@@ -50,6 +50,16 @@ public:
      * @brief     Read the active SFP mux channel
      */
     virtual uint32_t read_active_sfp_mux_channel() const = 0;
+
+    /**
+     * @brief     Number of SFP mux channels on the board
+     */
+    virtual uint32_t get_number_of_sfp_mux_channels() const = 0;
+
+    /**
+     * @brief     Read the loss of signal flags of the muxed SFPs, one bit per channel
+     */
+    virtual uint32_t read_sfp_los_flags() const = 0;
 };
 
 } // namespace timing
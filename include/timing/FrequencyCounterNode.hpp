@@ -45,9 +45,38 @@ public:
     /**
      * @brief     Measure clock frequencies.
      *
-     * @return     { description_of_the_return_value }
+     *            Each channel is read back as soon as the counter reports a valid
+     *            measurement taken entirely after the channel switch.
+     *
+     * @param[in]  number_of_clocks  Number of channels to measure, starting from 0
+     * @param[in]  timeout           Maximum wait per channel
+     *
+     * @return     Frequencies in MHz, -1 for channels without a valid measurement
+     */
+    std::vector<double> measure_frequencies(uint8_t number_of_clocks, std::chrono::milliseconds timeout=std::chrono::milliseconds(2000)) const;
+
+    /**
+     * @brief     Measure clock frequencies on several counters at once.
+     *
+     *            The firmware has one counter per block, multiplexed across the
+     *            channels, so channels are measured in turn; each counter however
+     *            advances independently, and the waits of all counters overlap.
+     *
+     * @param[in]  counters          Counters to measure
+     * @param[in]  number_of_clocks  Number of channels to measure on each counter
+     * @param[in]  timeout           Maximum wait per channel
+     *
+     * @return     Frequencies in MHz per counter, -1 for channels without a valid measurement
      */
-    std::vector<double> measure_frequencies(uint8_t number_of_clocks) const;
+    static std::vector<std::vector<double>> measure_frequencies(const std::vector<const FrequencyCounterNode*>& counters,
+                                                                const std::vector<uint8_t>& number_of_clocks,
+                                                                std::chrono::milliseconds timeout=std::chrono::milliseconds(2000));
+
+    /// Frequency corresponding to one count, in Hz
+    static const double kHzPerCount;
+
+    /// Length of one firmware measurement window
+    static const std::chrono::microseconds kGatePeriod;
 
 };
 
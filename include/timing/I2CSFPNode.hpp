@@ -14,6 +14,7 @@
 
 #include "timing/I2CSlave.hpp"
 #include "timing/I2CMasterNode.hpp"
+#include "timing/StatusSink.hpp"
 #include "timing/toolbox.hpp"
 #include "timing/timinghardwareinfo/Structs.hpp"
 #include "TimingIssues.hpp"
@@ -178,6 +179,11 @@ public:
      */
     std::string get_status(bool print_out=false) const;
 
+    /**
+     * @brief      Report SFP status to a sink
+     */
+    void report_status(StatusSink& sink) const;
+
     /**
      * @brief      Get and fill SFP hardware data
      */
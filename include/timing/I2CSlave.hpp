@@ -69,6 +69,11 @@ public:
 
     std::string get_master_id() const;
 
+    /**
+     * @brief      I2C master the slave is accessed through; its client is the one of the board.
+     */
+    const I2CMasterNode& get_master() const;
+
 protected:
     // Private constructor, accessible to I2CMaster
     I2CSlave(const I2CMasterNode* i2c_master, uint8_t i2c_device_address);
@@ -118,6 +118,14 @@ public:
      */
     virtual std::vector<double> read_clock_frequencies() const;
 
+    /**
+     * @brief      Read frequencies of on-board clocks on several boards at once.
+     *
+     * @return     Frequencies per IO node, in the order given
+     */
+    static std::vector<std::vector<double>> read_clock_frequencies(const std::vector<const IONode*>& io_nodes,
+                                                                   std::chrono::milliseconds timeout=std::chrono::milliseconds(2000));
+
     /**
      * @brief      Print frequencies of on-board clocks.
      */
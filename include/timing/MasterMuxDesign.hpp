@@ -80,9 +80,15 @@ public:
     virtual void apply_endpoint_delay(uint32_t address, uint32_t coarse_delay, uint32_t fine_delay, uint32_t phase_delay, bool measure_rtt, bool control_sfp, uint32_t sfp_mux) const;
 
     /**
-     * @brief      Apply delay to endpoint
+     * @brief      Scan the SFP mux for channels with a locking endpoint.
+     *
+     *             Channels reporting loss of signal are skipped without a lock attempt.
+     *
+     * @param[in]  lock_timeout  Per-channel upstream endpoint lock timeout, in milliseconds
+     *
+     * @return     Locked channels
      */
-    virtual std::vector<uint32_t> scan_sfp_mux() const;
+    virtual std::vector<uint32_t> scan_sfp_mux(uint32_t lock_timeout=100) const;
 
 // In leiu of UHAL_DERIVEDNODE
 protected:
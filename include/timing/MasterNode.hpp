@@ -59,7 +59,7 @@ public:
     /**
      * @brief     Enable RTT endpoint
      */
-    virtual void enable_upstream_endpoint() const = 0;
+    virtual void enable_upstream_endpoint(uint32_t timeout=500) const = 0;
 
     /**
      * @brief      Measure the endpoint round trip time.
@@ -67,6 +67,11 @@ public:
      * @return     { description_of_the_return_value }
      */
     virtual uint32_t measure_endpoint_rtt(uint32_t address, bool control_sfp=true) const = 0;
+
+    /**
+     * @brief      Measure the endpoint round trip time statistics over a series of echoes.
+     */
+    virtual RTTStatistics measure_endpoint_rtt_statistics(uint32_t address, uint32_t number_of_echoes, bool control_sfp=true) const = 0;
     
     /**
      * @brief     Apply delay to endpoint
@@ -79,9 +84,16 @@ public:
     virtual void apply_endpoint_delay(const ActiveEndpointConfig& ept_config, bool measure_rtt=false) const;
 
     /**
-     * @brief     Send a fixed length command
+     * @brief     Apply delays to a set of endpoints in one pass, without RTT measurements
+     */
+    virtual void apply_endpoint_delays(const std::vector<ActiveEndpointConfig>& ept_configs) const = 0;
+
+    /**
+     * @brief     Send a burst of fixed length commands
+     *
+     * @return     Timestamp captured alongside each command
      */
-    virtual void send_fl_cmd(uint32_t command, uint32_t channel, uint32_t number_of_commands=1) const = 0;
+    virtual std::vector<uint64_t> send_fl_cmd(uint32_t command, uint32_t channel, uint32_t number_of_commands=1) const = 0;
 
     /**
      * @brief      Get partition node
@@ -0,0 +1,126 @@
+/**
+ * @file MonitoringCollector.hpp
+ *
+ * MonitoringCollector runs periodic monitoring collection loops
+ * and keeps the latest snapshot of each of them.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_MONITORINGCOLLECTOR_HPP_
+#define TIMING_INCLUDE_TIMING_MONITORINGCOLLECTOR_HPP_
+
+// PDT Headers
+#include "timing/MonitoringHistory.hpp"
+
+// C++ Headers
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+struct MonitoringSnapshot {
+    std::string payload;
+    std::chrono::system_clock::time_point time_gathered;
+    uint64_t sequence;      // collections completed so far by the task
+    uint64_t failures;      // collections that threw
+};
+
+/**
+ * @brief      Periodic monitoring collection, one loop per subsystem.
+ *
+ *             Each task runs in its own thread with its own period, so fast
+ *             counters and slow hardware probes do not hold each other back.
+ *             Collections on the same device are serialised, since they share
+ *             its IPbus client; collections on different devices run
+ *             concurrently. After every successful collection the snapshot is kept
+ *             for in-process readers and handed to the publish function.
+ *             Tasks can also record counters and flags in the shared history,
+ *             which only stores the values that changed.
+ */
+class MonitoringCollector {
+
+public:
+    using CollectFunction = std::function<std::string()>;
+    using PublishFunction = std::function<void(const std::string&, const MonitoringSnapshot&)>;
+
+    explicit MonitoringCollector(PublishFunction publish=PublishFunction());
+    virtual ~MonitoringCollector();
+
+    /**
+     * @brief      Register a collection loop. Tasks can only be added while stopped.
+     *
+     * @param[in]  name     Task name, used to publish its snapshots
+     * @param[in]  device   Device read by the task; tasks on the same device do not collect at the same time
+     * @param[in]  period   Time between the starts of consecutive collections
+     * @param[in]  collect  Reads the hardware and returns the serialised snapshot
+     */
+    void add_task(const std::string& name, const std::string& device, std::chrono::milliseconds period, CollectFunction collect);
+
+    /**
+     * @brief      Start all collection loops.
+     */
+    void start();
+
+    /**
+     * @brief      Stop all collection loops, waiting for collections in progress.
+     */
+    void stop();
+
+    /**
+     * @brief      Latest snapshot of a task.
+     */
+    MonitoringSnapshot get_snapshot(const std::string& name) const;
+
+    /**
+     * @brief      Names of the registered tasks.
+     */
+    std::vector<std::string> get_task_names() const;
+
+    /**
+     * @brief      History of the counters and flags recorded by the tasks.
+     */
+    MonitoringHistory& get_history() { return m_history; }
+    const MonitoringHistory& get_history() const { return m_history; }
+
+private:
+    struct MonitoringTask {
+        std::string name;
+        std::chrono::milliseconds period;
+        CollectFunction collect;
+        MonitoringSnapshot latest;
+        std::mutex* device_mutex;
+    };
+
+    void run_task(MonitoringTask& task);
+    const MonitoringTask& find_task(const std::string& name) const;
+
+    const PublishFunction m_publish;
+    MonitoringHistory m_history;
+
+    std::vector<std::unique_ptr<MonitoringTask>> m_tasks;
+    std::vector<std::thread> m_threads;
+
+    mutable std::mutex m_snapshot_mutex;
+    std::map<std::string, std::unique_ptr<std::mutex>> m_device_mutexes;
+
+    std::mutex m_run_mutex;
+    std::condition_variable m_run_condition;
+    bool m_running;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_MONITORINGCOLLECTOR_HPP_
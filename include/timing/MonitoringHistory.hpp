@@ -0,0 +1,123 @@
+/**
+ * @file MonitoringHistory.hpp
+ *
+ * MonitoringHistory keeps the recent history of monitoring counters and
+ * flags in memory, delta-encoded in fixed-size ring buffers.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_MONITORINGHISTORY_HPP_
+#define TIMING_INCLUDE_TIMING_MONITORINGHISTORY_HPP_
+
+// C++ Headers
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+struct HistorySample {
+    std::chrono::system_clock::time_point time;
+    uint64_t value;
+};
+
+/**
+ * @brief      In-process time series of monitoring values, keyed by name.
+ *
+ *             Only changes are stored: recording a value equal to the latest
+ *             one of its series costs a map lookup. Each series is a ring of
+ *             blocks; a block starts with an absolute sample and continues with
+ *             varint-encoded time and value deltas. Once all blocks of a series
+ *             are full, the oldest one is dropped, so the memory of a series is
+ *             bounded by block_size * blocks_per_series.
+ */
+class MonitoringHistory {
+
+public:
+    /**
+     * @param[in]  block_size          Bytes of deltas per block
+     * @param[in]  blocks_per_series   Blocks kept per series
+     */
+    explicit MonitoringHistory(uint32_t block_size=4096, uint32_t blocks_per_series=16);
+    virtual ~MonitoringHistory();
+
+    /**
+     * @brief      Record the value of a series, if it changed.
+     *
+     * @return     True if the value was stored
+     */
+    bool record(const std::string& key, uint64_t value, std::chrono::system_clock::time_point time=std::chrono::system_clock::now());
+
+    /**
+     * @brief      Record a block of counters as series <prefix>.<index>.
+     *
+     * @return     Number of values stored
+     */
+    uint32_t record_counters(const std::string& prefix, const std::vector<uint32_t>& values, std::chrono::system_clock::time_point time=std::chrono::system_clock::now());
+
+    /**
+     * @brief      Stored changes of a series between two times, inclusive.
+     */
+    std::vector<HistorySample> query(const std::string& key, std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to) const;
+
+    /**
+     * @brief      Value of a series at a given time, i.e. its latest change up to then.
+     */
+    HistorySample value_at(const std::string& key, std::chrono::system_clock::time_point time) const;
+
+    /**
+     * @brief      Average rate of increase of a counter between two times, per second.
+     *
+     *             Decreases are told apart by counter_increase, as in
+     *             CounterRateEngine: a wraparound of a 32 bit value if it fits the
+     *             time between the samples, otherwise a counter reset, after which
+     *             the counter counted up from zero.
+     */
+    double rate(const std::string& key, std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to) const;
+
+    /**
+     * @brief      Names of the recorded series.
+     */
+    std::vector<std::string> get_keys() const;
+
+    /**
+     * @brief      Bytes used by the blocks of all series.
+     */
+    size_t get_memory_usage() const;
+
+private:
+    struct Block {
+        int64_t first_time;  // us since the epoch
+        uint64_t first_value;
+        std::vector<uint8_t> deltas;
+    };
+
+    struct Series {
+        std::vector<Block> blocks;  // ring, oldest after current once full
+        uint32_t current;           // block being filled
+        int64_t last_time;
+        uint64_t last_value;
+    };
+
+    void append(Series& series, int64_t time, uint64_t value);
+    std::vector<HistorySample> decode(const Series& series, int64_t from, int64_t to) const;
+    const Series& find_series(const std::string& key) const;
+
+    const uint32_t m_block_size;
+    const uint32_t m_blocks_per_series;
+
+    mutable std::mutex m_series_mutex;
+    std::map<std::string, Series> m_series;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_MONITORINGHISTORY_HPP_
@@ -61,6 +61,16 @@ public:
      */
     uint32_t read_active_sfp_mux_channel() const override;
 
+    /**
+     * @brief     Number of SFP mux channels, from the width of the LOS status field
+     */
+    uint32_t get_number_of_sfp_mux_channels() const override;
+
+    /**
+     * @brief     Read the loss of signal flags of the muxed SFPs, one bit per channel
+     */
+    uint32_t read_sfp_los_flags() const override;
+
     /**
      * @brief     Switch the SFP I2C mux channel
      */
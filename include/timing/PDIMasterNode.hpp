@@ -25,6 +25,7 @@
 // C++ Headers
 #include <chrono>
 #include <string>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
@@ -51,7 +52,7 @@ public:
     /**
      * @brief     Enable RTT endpoint
      */
-    void enable_upstream_endpoint() const override;
+    void enable_upstream_endpoint(uint32_t timeout=500) const override;
 
     /**
      * @brief      Measure the endpoint round trip time.
@@ -60,17 +61,31 @@ public:
      */
     uint32_t measure_endpoint_rtt(uint32_t address, bool control_sfp=true) const override;
 
+    /**
+     * @brief      Measure the endpoint round trip time statistics over a series of echoes.
+     *
+     *             The SFP switching and upstream endpoint lock are done once for all echoes.
+     */
+    RTTStatistics measure_endpoint_rtt_statistics(uint32_t address, uint32_t number_of_echoes, bool control_sfp=true) const override;
+
     /**
      * @brief     Apply delay to endpoint
      */
     void apply_endpoint_delay(uint32_t address, uint32_t coarse_delay, uint32_t fine_delay, uint32_t phase_delay, bool measure_rtt=false, bool control_sfp=true) const override;
 
     using MasterNode::apply_endpoint_delay;
+
+    /**
+     * @brief     Apply delays to a set of endpoints in one pass, without RTT measurements
+     */
+    void apply_endpoint_delays(const std::vector<ActiveEndpointConfig>& ept_configs) const override;
     
     /**
-     * @brief     Send a fixed length command
+     * @brief     Send a burst of fixed length commands
+     *
+     * @return     Timestamp captured alongside each command
      */
-    void send_fl_cmd(uint32_t command, uint32_t channel, uint32_t number_of_commands=1) const override;
+    std::vector<uint64_t> send_fl_cmd(uint32_t command, uint32_t channel, uint32_t number_of_commands=1) const override;
 
     /**
      * @brief     Configure fake trigger generator
@@ -117,15 +132,43 @@ public:
      */
     const PartitionNode& get_partition_node(uint32_t partition_id) const;
 
+    /**
+     * @brief     Configure and enable a group of partitions in a single dispatch
+     */
+    void configure_partitions(const std::vector<uint32_t>& partition_ids, uint32_t trigger_mask, bool enable_spill_gate, bool rate_control_enabled=true) const;
+
+    /**
+     * @brief     Start a group of partitions in a single dispatch and wait for all of them to be in run
+     *
+     * @return    Time between the run request and its acknowledgment by all partitions
+     */
+    std::chrono::microseconds start_partitions(const std::vector<uint32_t>& partition_ids, uint32_t timeout=5000) const;
+
+    /**
+     * @brief     Stop a group of partitions in a single dispatch and wait for all of them to leave the run
+     *
+     * @return    Time between the stop request and its acknowledgment by all partitions
+     */
+    std::chrono::microseconds stop_partitions(const std::vector<uint32_t>& partition_ids, uint32_t timeout=5000) const;
+
      /**
-     * @brief     Set timestamp to current machine time
+     * @brief     Set timestamp to current machine time, compensating for the IPbus latency
+     *
+     * @param[in]  samples  Number of timestamp reads used to measure the latency and the offset
+     *
+     * @return     Offset from the host clock achieved, with its uncertainty
      */
-    void sync_timestamp() const;
+    TimestampOffset sync_timestamp(uint32_t samples=16) const;
 
     /**
      * @brief     Fill the PD-I master monitoring structure.
      */
     void get_info(timingfirmwareinfo::TimingPDIMasterMonitorData& mon_data) const;
+
+    static const uint32_t kNumberOfPartitions;
+
+private:
+    std::vector<const PartitionNode*> get_partition_nodes(const std::vector<uint32_t>& partition_ids) const;
 };
 
 
@@ -0,0 +1,106 @@
+/**
+ * @file PartitionBufferPoller.hpp
+ *
+ * PartitionBufferPoller drains a partition readout buffer,
+ * adapting the polling interval to the measured occupancy.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_PARTITIONBUFFERPOLLER_HPP_
+#define TIMING_INCLUDE_TIMING_PARTITIONBUFFERPOLLER_HPP_
+
+// PDT Headers
+#include "timing/PartitionNode.hpp"
+
+// uHal Headers
+#include "uhal/ValMem.hpp"
+
+// C++ Headers
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+struct PartitionBufferPollerStats {
+    uint64_t polls;
+    uint64_t events_read;
+    uint32_t peak_word_count;
+    double peak_occupancy;
+    uint32_t warnings_seen;
+    uint32_t errors_seen;
+};
+
+/**
+ * @brief      Adaptive drain loop for a partition readout buffer.
+ *
+ *             The interval between polls is derived from the buffer fill rate
+ *             measured between consecutive polls: the poller aims to come back
+ *             before the buffer reaches the target occupancy. It drops to the
+ *             minimum interval as soon as the warning flag is seen, and backs
+ *             off exponentially while the buffer stays empty.
+ */
+class PartitionBufferPoller {
+
+public:
+    explicit PartitionBufferPoller(const PartitionNode& partition,
+                                   std::chrono::microseconds min_interval=std::chrono::microseconds(200),
+                                   std::chrono::microseconds max_interval=std::chrono::milliseconds(500),
+                                   double target_occupancy=0.5);
+    virtual ~PartitionBufferPoller();
+
+    /**
+     * @brief      Read the complete events currently in the buffer, up to a data port block, and update the poll interval.
+     *
+     * @return     Raw event words
+     */
+    uhal::ValVector<uint32_t> poll();
+
+    /**
+     * @brief      Sleep for the current poll interval, then poll.
+     *
+     * @return     Raw event words
+     */
+    uhal::ValVector<uint32_t> wait_and_poll();
+
+    /**
+     * @brief      Interval to wait before the next poll.
+     */
+    std::chrono::microseconds get_poll_interval() const;
+
+    /**
+     * @brief      Occupancy statistics accumulated since construction or the last reset.
+     */
+    const PartitionBufferPollerStats& get_stats() const;
+
+    /**
+     * @brief      Clear the accumulated statistics and restart from the maximum interval.
+     */
+    void reset_stats();
+
+private:
+    void update_interval(uint32_t words_before_drain, const PartitionBufferStatus& status, std::chrono::steady_clock::time_point now);
+
+    const PartitionNode& m_partition;
+    const std::chrono::microseconds m_min_interval;
+    const std::chrono::microseconds m_max_interval;
+    const double m_target_occupancy;
+    const uint32_t m_capacity;                   ///< FIFO depth, in words
+    const uint32_t m_read_size;                  ///< Most words read per poll, the data port size
+
+    std::chrono::microseconds m_interval;
+    std::chrono::steady_clock::time_point m_last_poll;
+    uint32_t m_words_left;
+    bool m_first_poll;
+
+    PartitionBufferPollerStats m_stats;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_PARTITIONBUFFERPOLLER_HPP_
@@ -46,6 +46,28 @@ struct PartitionCounts {
     std::vector<uint32_t> rejected;
 };
 
+struct PartitionBufferStatus {
+    uint32_t word_count;
+    bool warning;
+    bool error;
+};
+
+/**
+ * @brief      Event record of the partition readout buffer, as laid out in memory.
+ *
+ *             The timestamp is read out low word first, which maps onto a
+ *             little-endian 64 bit field; so a buffer of words can be viewed
+ *             as records without copying.
+ */
+struct PartitionEventRecord {
+    uint32_t header;
+    uint32_t command;
+    uint64_t timestamp;
+    uint32_t event_counter;
+    uint32_t checksum;
+};
+static_assert(sizeof(PartitionEventRecord) == 6 * sizeof(uint32_t), "PartitionEventRecord must match the 6 word event");
+
 /**
  * @brief      Class for partition node.
  */
@@ -92,15 +114,44 @@ public:
      * @return     { description_of_the_return_value }
      */
     bool read_rob_error() const;
+
+    /**
+     * @brief      Read the buffer occupancy together with the warning and error flags.
+     *
+     * @return     Buffer word count and flags, collected in a single dispatch
+     */
+    PartitionBufferStatus read_buffer_status() const;
+
+    /**
+     * @brief      Depth of the readout buffer FIFO, in words.
+     *
+     * @return     The depth parameter of the buf node in the address table, or
+     *             the largest word count buf.count can report if it has none
+     */
+    uint32_t get_buffer_capacity() const;
+
+    /**
+     * @brief      Size of the readout buffer data port, in words: the most words a single block read returns.
+     */
+    uint32_t get_buffer_read_size() const;
     
     /**
      * @brief      Read multiple events from the rob.
      *
      * @param[in]  number_of_events  Number of events to read
      *
-     * @return     Standard vector containing all events extracted from rob
+     * @return     Block read holding all events extracted from rob; copies share its memory
      */
-    std::vector<uint32_t> read_events( size_t number_of_events = 0 ) const;
+    uhal::ValVector< uint32_t > read_events( size_t number_of_events = 0 ) const;
+
+    /**
+     * @brief      Read a block of words from the rob, without checking the occupancy first.
+     *
+     * @param[in]  number_of_words  Number of words to read
+     *
+     * @return     Block read holding the words extracted from rob; copies share its memory
+     */
+    uhal::ValVector< uint32_t > read_buffer_data( uint32_t number_of_words ) const;
 
 
     /**
@@ -117,7 +168,7 @@ public:
      */
     // void writeTriggerMask( uint32_t aMask ) const;
 
-    void configure( uint32_t trigger_mask, bool enableSpillGate, bool rate_control_enabled=0x1 ) const;
+    void configure( uint32_t trigger_mask, bool enableSpillGate, bool rate_control_enabled=0x1, bool dispatch=true ) const;
     
     /**
      * @brief      Writes the trigger mask.
@@ -145,11 +196,13 @@ public:
      * @brief      Starts the partition.
      *
      *             Flushes the readout buffer, set the run bit and wait for
-     *             acknowledgment (to implement in v4)
+     *             acknowledgment. All register writes go out in a single dispatch.
      *
      * @param[in]  timeout  in milliseconds
+     *
+     * @return     Time between the run request and its acknowledgment
      */
-    void start( uint32_t timeout = 5000 ) const;
+    std::chrono::microseconds start( uint32_t timeout = 5000 ) const;
 
     /**
      * @brief      Stops the partition.
@@ -157,8 +210,35 @@ public:
      *             Disable readout buffer and triggers.
      *
      * @param[in]  timeout  in milliseconds
+     *
+     * @return     Time between the stop request and its acknowledgment
      */
-    void stop( uint32_t timeout = 5000 ) const;
+    std::chrono::microseconds stop( uint32_t timeout = 5000 ) const;
+
+    /**
+     * @brief      Queue the register writes for a run state transition.
+     *
+     *             For a start the readout buffer is flushed and triggers
+     *             disabled before the run bit is set.
+     *
+     * @param[in]  in_run    Requested run state
+     * @param[in]  dispatch  Dispatch the writes immediately
+     */
+    void request_run_state( bool in_run, bool dispatch=true ) const;
+
+    /**
+     * @brief      Poll the run status of a group of partitions until all match the requested state.
+     *
+     *             All status bits are read in a single dispatch, polling with
+     *             poll_until. The partitions must share the same client.
+     *
+     * @param[in]  partitions  Partitions to wait for
+     * @param[in]  in_run      Expected run state
+     * @param[in]  timeout     in milliseconds
+     *
+     * @return     Time elapsed until the state was observed on all partitions
+     */
+    static std::chrono::microseconds wait_for_run_state( const std::vector<const PartitionNode*>& partitions, bool in_run, uint32_t timeout );
 
 
     /**
@@ -173,6 +253,11 @@ public:
      */
     std::string get_status(bool print_out=false) const override;
 
+    /**
+     * @brief     Report the partition status to a sink.
+     */
+    void report_status(StatusSink& sink) const override;
+
     /**
      * @brief     Fill the partition monitoring structure.
      */
@@ -14,6 +14,7 @@
 
 #include "timing/SIChipSlave.hpp"
 #include "timing/I2CMasterNode.hpp"
+#include "timing/StatusSink.hpp"
 #include "timing/timinghardwareinfo/Structs.hpp"
 
 #include "ers/Issue.hpp"
@@ -66,6 +67,8 @@ public:
 
     void get_info(timinghardwareinfo::TimingPLLMonitorData& mon_data) const;
 
+    void report_status(StatusSink& sink) const;
+
 private:
     typedef boost::tuple<uint16_t, uint8_t>  RegisterSetting_t;
 
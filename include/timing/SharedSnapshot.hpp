@@ -0,0 +1,160 @@
+/**
+ * @file SharedSnapshot.hpp
+ *
+ * SharedSnapshotWriter and SharedSnapshotReader exchange monitoring
+ * snapshots between local processes through a shared-memory segment.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_SHAREDSNAPSHOT_HPP_
+#define TIMING_INCLUDE_TIMING_SHAREDSNAPSHOT_HPP_
+
+// C++ Headers
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+struct SharedSnapshot {
+    std::string name;
+    std::string payload;
+    std::chrono::system_clock::time_point time_gathered;
+    std::chrono::system_clock::time_point time_published;
+    uint64_t version;  // publications of this record so far
+};
+
+/**
+ * @brief      Layout of the shared-memory segment.
+ *
+ *             A header is followed by a fixed number of slots, one per record.
+ *             Each slot is protected by a sequence lock: the sequence is odd
+ *             while the writer updates the slot, and readers retry until they
+ *             copy the slot between two identical even sequence values.
+ */
+namespace shared_snapshot {
+
+const uint64_t kMagic = 0x544d4e47534e4150; // "TMNGSNAP"
+const uint32_t kLayoutVersion = 1;
+const size_t kMaxNameLength = 64;
+const size_t kAlignment = 64;
+const std::chrono::milliseconds kMaxReadTime(100);  // readers give up on a slot held by the writer for longer
+
+struct Header {
+    std::atomic<uint64_t> magic;        // written last, once the segment is initialised
+    uint32_t layout_version;
+    uint32_t number_of_slots;
+    uint32_t slot_capacity;              // payload bytes per slot
+    uint32_t slot_stride;
+    uint32_t slots_offset;               // from the start of the segment
+    std::atomic<uint32_t> slots_used;
+};
+
+struct Slot {
+    std::atomic<uint64_t> sequence;
+    char name[kMaxNameLength];
+    int64_t time_gathered;               // ns since the epoch
+    int64_t time_published;              // ns since the epoch
+    uint64_t version;
+    uint32_t size;
+    // payload follows
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Sequence locks need lock-free 64 bit atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Slot allocation needs lock-free 32 bit atomics");
+
+} // namespace shared_snapshot
+
+/**
+ * @brief      Single writer of a shared snapshot segment.
+ *
+ *             The segment is created, or recreated, on construction and removed
+ *             on destruction; readers that already mapped it keep their mapping.
+ */
+class SharedSnapshotWriter {
+
+public:
+    /**
+     * @param[in]  name             Shared-memory object name, e.g. "/pdtguardian"
+     * @param[in]  number_of_slots  Maximum number of records
+     * @param[in]  slot_capacity    Maximum payload size of a record, in bytes
+     */
+    SharedSnapshotWriter(const std::string& name, uint32_t number_of_slots=64, uint32_t slot_capacity=65536);
+    virtual ~SharedSnapshotWriter();
+
+    SharedSnapshotWriter(const SharedSnapshotWriter&) = delete;
+    SharedSnapshotWriter& operator=(const SharedSnapshotWriter&) = delete;
+
+    /**
+     * @brief      Publish a new version of a record, allocating its slot on first use.
+     */
+    void publish(const std::string& record, const std::string& payload, std::chrono::system_clock::time_point time_gathered);
+
+private:
+    shared_snapshot::Slot& get_slot(uint32_t index) const;
+
+    const std::string m_name;
+    size_t m_size;
+    void* m_segment;
+    shared_snapshot::Header* m_header;
+    std::map<std::string, uint32_t> m_slot_indices;
+};
+
+/**
+ * @brief      Reader of a shared snapshot segment.
+ *
+ *             Reads are plain memory copies: no system calls and no hardware
+ *             access once the segment is mapped. Any number of readers can run
+ *             alongside the writer.
+ */
+class SharedSnapshotReader {
+
+public:
+    explicit SharedSnapshotReader(const std::string& name);
+    virtual ~SharedSnapshotReader();
+
+    SharedSnapshotReader(const SharedSnapshotReader&) = delete;
+    SharedSnapshotReader& operator=(const SharedSnapshotReader&) = delete;
+
+    /**
+     * @brief      Consistent copy of the latest version of a record.
+     *
+     *             Throws SharedSnapshotReadTimeout if the writer holds the slot
+     *             for longer than shared_snapshot::kMaxReadTime, e.g. after dying mid-copy.
+     */
+    SharedSnapshot read(const std::string& record);
+
+    /**
+     * @brief      Consistent copies of all records.
+     */
+    std::vector<SharedSnapshot> read_all();
+
+    /**
+     * @brief      Names of the records published so far.
+     */
+    std::vector<std::string> get_record_names();
+
+private:
+    void refresh_slot_indices();
+    SharedSnapshot read_slot(uint32_t index) const;
+    const shared_snapshot::Slot& get_slot(uint32_t index) const;
+
+    const std::string m_name;
+    size_t m_size;
+    void* m_segment;
+    const shared_snapshot::Header* m_header;
+    std::map<std::string, uint32_t> m_slot_indices;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_SHAREDSNAPSHOT_HPP_
@@ -0,0 +1,198 @@
+/**
+ * @file SimulatedBoard.hpp
+ *
+ * SimulatedBoard emulates the registers of the ouroboros-sim design:
+ * master, partitions, endpoints, IO and the PLL I2C bus. Addresses and masks are taken
+ * from the design address table, so the model follows the table rather
+ * than hard-coding the layout.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_SIMULATEDBOARD_HPP_
+#define TIMING_INCLUDE_TIMING_SIMULATEDBOARD_HPP_
+
+// uHal Headers
+#include "uhal/Node.hpp"
+
+// C++ Headers
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+struct SimulatedBoardConfig {
+    uint32_t buffer_depth;                       ///< Readout buffer depth, in words
+    std::chrono::microseconds run_latency;       ///< Delay between a run request and the change of run state
+    uint32_t echo_delay;                         ///< Echo round trip time, in clock ticks
+    uint32_t seed;                               ///< Seed of the poisson trigger generators
+    uint32_t acmd_delay = 50;                    ///< Time to send an async command, in clock ticks
+};
+
+/**
+ * @brief      Register level emulation of the ouroboros-sim timing design.
+ *
+ *             The board state advances with the wall clock when it is accessed:
+ *             the timestamp counts at the DUNE SP clock rate, the fake trigger
+ *             generators issue commands at the rates programmed in scmd_gen,
+ *             and the commands accepted by the partitions in run fill their
+ *             readout buffers. I2C masters complete their transfers at once; the
+ *             slaves declared in their parameters answer as paged register
+ *             files, as the SI534x chips. Registers without a behaviour are
+ *             plain storage. All accesses are serialised.
+ */
+class SimulatedBoard {
+
+public:
+    /**
+     * @brief      Build the model from the top node of an ouroboros-sim address table.
+     */
+    SimulatedBoard(const uhal::Node& top, const SimulatedBoardConfig& config);
+    virtual ~SimulatedBoard();
+
+    SimulatedBoard(const SimulatedBoard&) = delete;
+    SimulatedBoard& operator=(const SimulatedBoard&) = delete;
+
+    /**
+     * @brief      Read a word; reads of a readout buffer port pop the buffer.
+     */
+    uint32_t read(uint32_t address);
+
+    /**
+     * @brief      Write a word.
+     */
+    void write(uint32_t address, uint32_t value);
+
+    /**
+     * @brief      Program a fake trigger generator, as FLCmdGeneratorNode::enable_fake_trigger.
+     */
+    void enable_fake_trigger(uint32_t channel, uint32_t divisor, uint32_t prescale, bool poisson);
+
+    /**
+     * @brief      Bring the board state up to now; keeps the backlog of commands short while the board is idle.
+     */
+    void advance();
+
+    /**
+     * @brief      Current timestamp, in clock ticks.
+     */
+    uint64_t read_timestamp();
+
+    /**
+     * @brief      Number of commands issued by the generators since start.
+     */
+    uint64_t get_command_count() const;
+
+private:
+    struct Field {
+        uint32_t address;
+        uint32_t mask;
+    };
+
+    struct GeneratorMasks {
+        uint32_t en, patt, force, type, rate_div_p, rate_div_d;
+    };
+
+    struct Generator {
+        uint32_t ctrl;
+        uint64_t next;                           ///< Tick of the next command
+    };
+
+    struct Partition {
+        Field part_en, run_req, trig_en, buf_en, trig_ctr_rst, trig_mask;
+        bool in_run;
+        bool run_pending;
+        std::chrono::steady_clock::time_point run_deadline;
+        bool buffer_error;
+        uint32_t event_counter;
+        std::deque<uint32_t> buffer;
+        std::vector<uint32_t> accepted;
+        std::vector<uint32_t> rejected;
+    };
+
+    struct Endpoint {
+        Field ep_en, buf_en, ctr_rst, tgrp;
+        bool buffer_error;
+        uint32_t event_counter;
+        std::deque<uint32_t> buffer;
+        std::vector<uint32_t> counters;
+    };
+
+    struct I2CSlave {
+        uint8_t page;                            ///< Page register, 0x1 on every page
+        uint8_t pointer;                         ///< Register address, advances on every byte
+        std::unordered_map<uint16_t, uint8_t> registers;
+    };
+
+    struct I2CBus {
+        uint32_t rx;
+        uint32_t status;
+        std::unordered_map<uint8_t, I2CSlave> slaves;
+        I2CSlave* selected;                      ///< Slave addressed since the last start, if any
+        bool reading;
+        bool pointer_pending;                    ///< The next byte written is the register address
+    };
+
+    Field resolve(const uhal::Node& node) const;
+    uint32_t get_field(const Field& field) const;
+    void set_field(const Field& field, uint32_t value);
+
+    void on_read(const uhal::Node& node, std::function<uint32_t()> reader);
+    void on_write(const uhal::Node& node, std::function<void(uint32_t)> writer);      ///< The writer gets the previous word
+    void on_block_read(const uhal::Node& node, std::function<uint32_t(uint32_t)> reader);
+
+    void build_io(const uhal::Node& io);
+    void build_i2c(const uhal::Node& i2c);
+    void execute_i2c(I2CBus& bus, uint32_t command, uint32_t data);
+    void build_master(const uhal::Node& master);
+    void build_partition(const uhal::Node& partition);
+    void build_endpoint(const uhal::Node& endpoint);
+
+    void reset_state();
+
+    uint64_t get_tick(std::chrono::steady_clock::time_point time) const;
+    uint64_t get_period(const Generator& generator) const;
+    uint64_t get_interval(const Generator& generator);
+    void update();
+    void issue_command(uint32_t channel, uint32_t command, uint64_t timestamp);
+    bool push_event(std::deque<uint32_t>& buffer, bool& buffer_error, uint32_t command, uint64_t timestamp, uint32_t event_counter);
+
+    const SimulatedBoardConfig m_config;
+
+    mutable std::mutex m_mutex;
+    std::mt19937 m_random;
+
+    std::unordered_map<uint32_t, uint32_t> m_registers;
+    std::unordered_map<uint32_t, std::function<uint32_t()>> m_readers;
+    std::unordered_map<uint32_t, std::function<void(uint32_t)>> m_writers;
+
+    std::chrono::steady_clock::time_point m_epoch;
+    uint64_t m_epoch_timestamp;
+    std::chrono::steady_clock::time_point m_now;
+
+    GeneratorMasks m_gen_masks;
+    std::vector<Generator> m_generators;
+    std::vector<uint32_t> m_gen_accepted;
+    std::vector<uint32_t> m_gen_rejected;
+    uint64_t m_commands;
+
+    uint64_t m_acmd_done;                        ///< Tick at which the last async command is sent
+
+    std::vector<Partition> m_partitions;
+    std::vector<Endpoint> m_endpoints;
+    std::vector<I2CBus> m_i2c_buses;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_SIMULATEDBOARD_HPP_
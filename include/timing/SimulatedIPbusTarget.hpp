@@ -0,0 +1,88 @@
+/**
+ * @file SimulatedIPbusTarget.hpp
+ *
+ * SimulatedIPbusTarget answers IPbus 2.0 packets from the registers of a
+ * SimulatedBoard. It only deals with packets; the transport is left to
+ * the caller, the pdtsimulator UDP loop or a unit test.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_SIMULATEDIPBUSTARGET_HPP_
+#define TIMING_INCLUDE_TIMING_SIMULATEDIPBUSTARGET_HPP_
+
+// PDT Headers
+#include "timing/SimulatedBoard.hpp"
+
+// C++ Headers
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+/**
+ * @brief      IPbus 2.0 target on top of a simulated board.
+ *
+ *             Control packets are executed in order of packet ID, keeping the
+ *             last replies for resend requests; status packets report the next
+ *             expected ID. Packets are answered in the byte order they came in.
+ *             The packet counters can be read while another thread serves.
+ */
+class SimulatedIPbusTarget {
+
+public:
+    static const uint32_t kMTU = 1500;
+    static const uint32_t kReplyBuffers = 16;
+
+    explicit SimulatedIPbusTarget(SimulatedBoard& board);
+    virtual ~SimulatedIPbusTarget();
+
+    SimulatedIPbusTarget(const SimulatedIPbusTarget&) = delete;
+    SimulatedIPbusTarget& operator=(const SimulatedIPbusTarget&) = delete;
+
+    /**
+     * @brief      Handle a request; returns false if there is nothing to send back.
+     */
+    bool handle(const std::vector<uint32_t>& request, std::vector<uint32_t>& reply);
+
+    /**
+     * @brief      Number of control packets executed.
+     */
+    uint64_t get_packets() const { return m_packets; }
+
+    /**
+     * @brief      Number of transactions executed.
+     */
+    uint64_t get_transactions() const { return m_transactions; }
+
+    /**
+     * @brief      Number of bytes in the control packets executed and their replies.
+     */
+    uint64_t get_bytes() const { return m_bytes; }
+
+private:
+    static bool is_packet_header(uint32_t header);
+
+    bool handle_control(const std::vector<uint32_t>& request, uint32_t id, std::vector<uint32_t>& reply);
+    void handle_status(uint32_t header, std::vector<uint32_t>& reply);
+    bool find_reply(uint32_t id, std::vector<uint32_t>& reply) const;
+    void execute(const std::vector<uint32_t>& request, std::vector<uint32_t>& reply);
+
+    SimulatedBoard& m_board;
+    uint32_t m_next_id;
+    std::deque<std::pair<uint32_t, std::vector<uint32_t>>> m_replies;
+    std::atomic<uint64_t> m_packets;
+    std::atomic<uint64_t> m_transactions;
+    std::atomic<uint64_t> m_bytes;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_SIMULATEDIPBUSTARGET_HPP_
@@ -0,0 +1,156 @@
+/**
+ * @file StatusSink.hpp
+ *
+ * StatusSink receives the structured status of timing nodes, and
+ * StatusRenderers turn it into text tables, JSON or binary records.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_STATUSSINK_HPP_
+#define TIMING_INCLUDE_TIMING_STATUSSINK_HPP_
+
+// uHal Headers
+#include "uhal/ValMem.hpp"
+
+// C++ Headers
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+/**
+ * @brief      Receiver of structured status.
+ *
+ *             Nodes report named, typed values grouped in sections, without
+ *             formatting anything; what to do with them is up to the sink.
+ *             Sections can be nested.
+ */
+class StatusSink {
+
+public:
+    virtual ~StatusSink() {}
+
+    virtual void begin_section(const std::string& name) = 0;
+    virtual void end_section() = 0;
+
+    virtual void add_register(const std::string& name, uint64_t value) = 0;
+    virtual void add_flag(const std::string& name, bool value) = 0;
+    virtual void add_number(const std::string& name, double value, const std::string& unit="") = 0;
+    virtual void add_text(const std::string& name, const std::string& value) = 0;
+    virtual void add_counters(const std::string& name, const std::vector<std::string>& labels, const std::vector<uint32_t>& values) = 0;
+
+    /**
+     * @brief      Report a set of registers, as returned by TimingNode::read_sub_nodes.
+     */
+    void add_registers(const std::map<std::string, uhal::ValWord<uint32_t>>& registers);
+};
+
+/**
+ * @brief      Renders the status as the tables printed by get_status.
+ */
+class TextStatusRenderer : public StatusSink {
+
+public:
+    TextStatusRenderer();
+    virtual ~TextStatusRenderer();
+
+    void begin_section(const std::string& name) override;
+    void end_section() override;
+
+    void add_register(const std::string& name, uint64_t value) override;
+    void add_flag(const std::string& name, bool value) override;
+    void add_number(const std::string& name, double value, const std::string& unit="") override;
+    void add_text(const std::string& name, const std::string& value) override;
+    void add_counters(const std::string& name, const std::vector<std::string>& labels, const std::vector<uint32_t>& values) override;
+
+    const std::string& get_text() const { return m_text; }
+
+private:
+    void flush_rows();
+
+    std::vector<std::string> m_sections;
+    std::vector<std::pair<std::string, std::string>> m_rows;
+    std::string m_text;
+};
+
+/**
+ * @brief      Renders the status as a JSON object, one nested object per section.
+ */
+class JsonStatusRenderer : public StatusSink {
+
+public:
+    JsonStatusRenderer();
+    virtual ~JsonStatusRenderer();
+
+    void begin_section(const std::string& name) override;
+    void end_section() override;
+
+    void add_register(const std::string& name, uint64_t value) override;
+    void add_flag(const std::string& name, bool value) override;
+    void add_number(const std::string& name, double value, const std::string& unit="") override;
+    void add_text(const std::string& name, const std::string& value) override;
+    void add_counters(const std::string& name, const std::vector<std::string>& labels, const std::vector<uint32_t>& values) override;
+
+    /**
+     * @brief      The JSON document; sections left open are closed.
+     */
+    std::string get_json() const;
+
+private:
+    void add_key(const std::string& name);
+
+    std::string m_json;
+    std::vector<bool> m_first_in_section;
+};
+
+/**
+ * @brief      Renders the status as a compact binary record.
+ *
+ *             The record starts with kBinaryStatusVersion, followed by one
+ *             entry per call: a tag byte, the name and the value, encoded as in
+ *             timing/BinaryCodec.hpp. Counters carry their labels and values.
+ */
+class BinaryStatusRenderer : public StatusSink {
+
+public:
+    enum Tag : uint8_t {
+        kBeginSection = 1,
+        kEndSection,
+        kRegister,
+        kFlag,
+        kNumber,
+        kText,
+        kCounters
+    };
+
+    static const uint32_t kBinaryStatusVersion;
+
+    BinaryStatusRenderer();
+    virtual ~BinaryStatusRenderer();
+
+    void begin_section(const std::string& name) override;
+    void end_section() override;
+
+    void add_register(const std::string& name, uint64_t value) override;
+    void add_flag(const std::string& name, bool value) override;
+    void add_number(const std::string& name, double value, const std::string& unit="") override;
+    void add_text(const std::string& name, const std::string& value) override;
+    void add_counters(const std::string& name, const std::vector<std::string>& labels, const std::vector<uint32_t>& values) override;
+
+    const std::string& get_buffer() const { return m_buffer; }
+
+private:
+    std::string m_buffer;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_STATUSSINK_HPP_
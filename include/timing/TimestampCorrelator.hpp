@@ -0,0 +1,117 @@
+/**
+ * @file TimestampCorrelator.hpp
+ *
+ * TimestampCorrelator predicts the timing-system timestamp from the
+ * host clock, using a model fitted to occasional timestamp reads.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_TIMESTAMPCORRELATOR_HPP_
+#define TIMING_INCLUDE_TIMING_TIMESTAMPCORRELATOR_HPP_
+
+// C++ Headers
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+namespace dunedaq {
+namespace timing {
+
+struct TimestampEstimate {
+    uint64_t timestamp;             // in clock ticks
+    std::chrono::nanoseconds error; // bound on the distance to the true timestamp
+};
+
+/**
+ * @brief      Host clock to timing clock correlation.
+ *
+ *             Each update takes a few timestamp reads, bracketed by the host
+ *             steady clock, and keeps the one with the shortest round trip. An
+ *             offset and a drift relative to the nominal clock frequency are
+ *             fitted over the recent updates. Estimates between updates cost no
+ *             IPbus access; their error bound is half the round trip of the last
+ *             update, plus the fit residual, plus the drift uncertainty times the
+ *             time elapsed since the last update.
+ *
+ *             A read that disagrees with the model beyond the error bounds, e.g.
+ *             after the timestamp was set, restarts the fit.
+ */
+class TimestampCorrelator {
+
+public:
+    /**
+     * @param[in]  read_timestamp      Reads the board timestamp; one IPbus round trip
+     * @param[in]  max_error           Error bound above which now() updates the model
+     * @param[in]  samples_per_update  Timestamp reads per update
+     * @param[in]  history             Number of updates kept for the fit
+     */
+    explicit TimestampCorrelator(std::function<uint64_t()> read_timestamp,
+                                 std::chrono::nanoseconds max_error=std::chrono::microseconds(10),
+                                 uint32_t samples_per_update=8,
+                                 uint32_t history=16);
+    virtual ~TimestampCorrelator();
+
+    /**
+     * @brief      Current timing-system timestamp.
+     *
+     *             The model is updated first if the error bound has grown beyond
+     *             max_error, and beyond twice the bound of a fresh update.
+     */
+    TimestampEstimate now();
+
+    /**
+     * @brief      Timing-system timestamp at a given host time, from the current model only.
+     */
+    TimestampEstimate estimate(std::chrono::steady_clock::time_point host_time) const;
+
+    /**
+     * @brief      Sample the board timestamp and refit the model.
+     */
+    void update();
+
+    /**
+     * @brief      Fitted drift of the timing clock relative to the host clock, as a fraction of the nominal frequency.
+     */
+    double get_drift() const;
+
+    /**
+     * @brief      Number of updates performed since construction.
+     */
+    uint32_t get_number_of_updates() const;
+
+private:
+    struct CorrelationPoint {
+        std::chrono::steady_clock::time_point host_time;
+        uint64_t timestamp;
+        std::chrono::nanoseconds error;
+    };
+
+    CorrelationPoint sample() const;
+    void fit();
+
+    const std::function<uint64_t()> m_read_timestamp;
+    const std::chrono::nanoseconds m_max_error;
+    const uint32_t m_samples_per_update;
+    const uint32_t m_history;
+
+    std::deque<CorrelationPoint> m_points;
+    uint32_t m_updates;
+
+    // Model, relative to the newest point: timestamp = newest + m_intercept + (kNominalTicksPerNs + m_rate_correction) * dt, in ticks and ns
+    double m_intercept;
+    double m_rate_correction;
+    double m_residual;
+    double m_drift_error;
+
+    static const double kNominalTicksPerNs;
+    static const double kUnknownDriftBound;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_TIMESTAMPCORRELATOR_HPP_
@@ -58,6 +58,29 @@ public:
      * @brief      Read the current timestamp words.
      */
     void set_timestamp(uint64_t timestamp) const;
+
+    /**
+     * @brief      Measure the offset of the timestamp from the host clock.
+     *
+     *             Each sample pairs a timestamp read with the host time halfway
+     *             through its round trip; the sample with the shortest round trip
+     *             is kept.
+     *
+     * @param[in]  samples  Number of timestamp reads
+     */
+    TimestampOffset measure_host_offset(uint32_t samples=16) const;
+
+    /**
+     * @brief      Set the timestamp to the host time, compensating for the IPbus latency.
+     *
+     *             The value written is the host time at which the write is expected
+     *             to land, estimated from the shortest read round trip.
+     *
+     * @param[in]  samples  Number of timestamp reads used for each offset measurement
+     *
+     * @return     Offset achieved, measured after the write
+     */
+    TimestampOffset set_timestamp_from_host(uint32_t samples=16) const;
 };
 
 
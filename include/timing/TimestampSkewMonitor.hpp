@@ -0,0 +1,111 @@
+/**
+ * @file TimestampSkewMonitor.hpp
+ *
+ * TimestampSkewMonitor compares the timestamps of the boards in a
+ * timing system and tracks their offsets over time.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_INCLUDE_TIMING_TIMESTAMPSKEWMONITOR_HPP_
+#define TIMING_INCLUDE_TIMING_TIMESTAMPSKEWMONITOR_HPP_
+
+// C++ Headers
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+struct TimestampSource {
+    std::string name;
+    std::function<uint64_t()> read_timestamp; // one IPbus round trip
+};
+
+struct TimestampSkew {
+    std::string name;
+    int64_t offset;        // relative to the reference board, in clock ticks
+    uint64_t uncertainty;  // in clock ticks
+    int64_t drift;         // offset change from the median of the history, in clock ticks
+    uint64_t drift_uncertainty;  // uncertainty of this offset plus that of the median, in clock ticks
+    bool drifting;
+};
+
+/**
+ * @brief      Cross-board timestamp skew monitor.
+ *
+ *             All boards are read at once, each from its own thread, and every
+ *             read is bracketed by the host steady clock. The timestamps are
+ *             projected onto a common host time using the nominal clock
+ *             frequency, so that the host latency only enters through the
+ *             uncertainty of each read, half its round trip.
+ *
+ *             Offsets are taken relative to the first source. A board whose
+ *             offset moves away from the median of its history by more than
+ *             the tolerance plus the uncertainties of both the new offset and
+ *             the median, e.g. after losing phase lock, is flagged as drifting.
+ */
+class TimestampSkewMonitor {
+
+public:
+    /**
+     * Default tolerance: 100 us at the 50 MHz clock, above the half round
+     * trip of an IPbus read on a LAN, which bounds the uncertainty of a read.
+     */
+    static const uint64_t kDefaultTolerance = 5000;
+
+    /**
+     * @param[in]  sources    Boards to compare; the first one is the reference
+     * @param[in]  history    Number of measurements kept
+     * @param[in]  tolerance  Offset change tolerated before a board is flagged, in clock ticks
+     */
+    explicit TimestampSkewMonitor(const std::vector<TimestampSource>& sources, uint32_t history=64, uint64_t tolerance=kDefaultTolerance);
+    virtual ~TimestampSkewMonitor();
+
+    /**
+     * @brief      Read all boards, record the offsets and flag drifting boards.
+     *
+     * @return     Offsets of all boards relative to the reference
+     */
+    std::vector<TimestampSkew> measure();
+
+    /**
+     * @brief      Offset of one board relative to another, from the latest measurement.
+     */
+    TimestampSkew get_pairwise_offset(uint32_t from, uint32_t to) const;
+
+    /**
+     * @brief      Recorded measurements, oldest first.
+     */
+    std::vector<std::vector<TimestampSkew>> get_history() const;
+
+private:
+    struct TimestampReading {
+        std::chrono::steady_clock::time_point host_time;
+        uint64_t timestamp;
+        std::chrono::nanoseconds error;
+    };
+
+    std::vector<TimestampReading> read_all() const;
+    TimestampSkew compare(const TimestampReading& from, const TimestampReading& to) const;
+
+    const std::vector<TimestampSource> m_sources;
+    const uint32_t m_history;
+    const uint64_t m_tolerance;
+
+    // Ring buffer of measurements; m_next is the slot overwritten next
+    std::vector<std::vector<TimestampSkew>> m_measurements;
+    uint32_t m_next;
+
+    std::vector<TimestampReading> m_last_readings;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_INCLUDE_TIMING_TIMESTAMPSKEWMONITOR_HPP_
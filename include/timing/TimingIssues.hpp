@@ -204,6 +204,90 @@ ERS_DECLARE_ISSUE(timing,
                   ((double)trig_rate)((uint)ps)                                                                                    ///< Message parameters
 )
 
+ERS_DECLARE_ISSUE(timing,                                                                       ///< Namespace
+                  VLCmdTimeout,                                                                   ///< Issue class name
+                  " Timeout whilst sending command to endpoint " << std::to_string(address),      ///< Message
+                  ((uint)address)                                                                 ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                       ///< Namespace
+                  EndpointDelayOutOfRange,                                                        ///< Issue class name
+                  " Endpoint " << endpoint_id << " requires coarse delay " << std::to_string(coarse_delay) << ", out of range.", ///< Message
+                  ((std::string)endpoint_id)((uint)coarse_delay)                                  ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                     ///< Namespace
+                  TimestampSkewDrift,                                                        ///< Issue class name
+                  " Timestamp of " << board << " drifted by " << std::to_string(drift) << " ticks", ///< Message
+                  ((std::string)board)((int64_t)drift)                                       ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  MonitoringTaskFailed,                                                 ///< Issue class name
+                  " Monitoring task " << task << " failed: " << reason,                 ///< Message
+                  ((std::string)task)((std::string)reason)                              ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  MonitoringTaskNotFound,                                               ///< Issue class name
+                  " No monitoring task named " << task,                                 ///< Message
+                  ((std::string)task)                                                   ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  SharedMemoryError,                                                    ///< Issue class name
+                  " Shared memory segment " << segment << ": " << reason,               ///< Message
+                  ((std::string)segment)((std::string)reason)                           ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  SharedSnapshotTooLarge,                                               ///< Issue class name
+                  " Snapshot " << record << " of " << std::to_string(size) << " bytes exceeds the slot capacity of " << std::to_string(capacity), ///< Message
+                  ((std::string)record)((size_t)size)((uint)capacity)                   ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  SharedSnapshotNotFound,                                               ///< Issue class name
+                  " No record " << record << " in shared memory segment " << segment,   ///< Message
+                  ((std::string)segment)((std::string)record)                           ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  SharedSnapshotReadTimeout,                                            ///< Issue class name
+                  " Record " << record << " in shared memory segment " << segment << " still being written after " << std::to_string(timeout) << " ms", ///< Message
+                  ((std::string)segment)((std::string)record)((int64_t)timeout)        ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  HistorySeriesNotFound,                                                ///< Issue class name
+                  " No monitoring history for " << key,                                 ///< Message
+                  ((std::string)key)                                                    ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  CounterBlockNotFound,                                                 ///< Issue class name
+                  " No counter block named " << name,                                   ///< Message
+                  ((std::string)name)                                                   ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  BinaryCodecError,                                                     ///< Issue class name
+                  " Cannot decode binary record: " << reason,                           ///< Message
+                  ((std::string)reason)                                                 ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  BinaryCodecSchemaMismatch,                                            ///< Issue class name
+                  " Binary record schema hash 0x" << std::hex << found << " does not match expected 0x" << expected, ///< Message
+                  ((uint64_t)expected)((uint64_t)found)                                 ///< Message parameters
+)
+
+ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
+                  FLCommandsRejected,                                                   ///< Issue class name
+                  " Generator " << channel << " had " << rejected << " commands rejected; " << accepted << " of " << requested << " were accepted", ///< Message
+                  ((uint32_t)channel)((size_t)accepted)((uint32_t)requested)((uint32_t)rejected) ///< Message parameters
+)
+
 ERS_DECLARE_ISSUE(timing,                                                                  ///< Namespace
                   UpstreamEndpointFailedToLock,                                         ///< Issue class name
                   " Failed to bring up the RTT endpoint. Current state: " << ept_state, ///< Message
@@ -16,6 +16,8 @@
 #include "TimingIssues.hpp"
 #include "timing/definitions.hpp"
 #include "timing/toolbox.hpp"
+#include "timing/StatusSink.hpp"
+#include "timing/DispatchAccounting.hpp"
 #include "ers/Issue.hpp"
 
 // uHal Headers
@@ -39,8 +41,17 @@ public:
 
     /**
      * @brief     Get the status string of the timing node. Optionally print it
+     *
+     *            By default this is report_status rendered by TextStatusRenderer.
      */
-    virtual std::string get_status(bool print_out=false) const = 0;
+    virtual std::string get_status(bool print_out=false) const;
+
+    /**
+     * @brief     Report the status of the timing node to a sink, without formatting it.
+     *
+     *            By default the csr.ctrl and csr.stat registers are reported, when present.
+     */
+    virtual void report_status(StatusSink& sink) const;
 
     /**
      * @brief     Read subnodes.
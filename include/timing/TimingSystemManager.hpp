@@ -87,6 +87,21 @@ public:
      */
     void stopPartition(uint32_t partition_id) const override;
 
+    /**
+     * @brief      Configure and enable a group of timing system partitions
+     */
+    void configurePartitions(const std::vector<uint32_t>& partition_ids, uint32_t trigger_mask, bool enableSpillGate) const override;
+
+    /**
+     * @brief      Start a group of timing system partitions together
+     */
+    void startPartitions(const std::vector<uint32_t>& partition_ids) const override;
+
+    /**
+     * @brief      Stop a group of timing system partitions together
+     */
+    void stopPartitions(const std::vector<uint32_t>& partition_ids) const override;
+
     /**
      * @brief      Read the current timestamp
      *
@@ -94,6 +109,11 @@ public:
      */
     uint64_t read_master_timestamp() const override;
 
+    /**
+     * @brief      Timestamp readers for the masters and endpoints.
+     */
+    std::vector<TimestampSource> get_timestamp_sources() const override;
+
     /**
      * @brief      Measure the endpoint round trip time.
      *
@@ -108,15 +128,25 @@ public:
      */
     uint64_t measure_endpoint_rtt(const ActiveEndpointConfig& ept_config) const override;
 
+    /**
+     * @brief      Measure the endpoint round trip time statistics over a series of echoes.
+     */
+    RTTStatistics measure_endpoint_rtt_statistics(const ActiveEndpointConfig& ept_config, uint32_t number_of_echoes) const override;
+
     /**
      * @brief      Measure the round trip time for endpoints.
      */
-    std::vector<EndpointRTTResult> performEndpointRTTScan() override;
+    std::vector<EndpointRTTResult> performEndpointRTTScan(uint32_t number_of_echoes=1) override;
 
     /**
      * @brief      Adjust the endpoint delays.
      */
     void apply_endpoint_delays(uint32_t measure_rtt) const override;
+
+    /**
+     * @brief      Scan, solve and apply the endpoint delays, then verify with a second scan.
+     */
+    std::vector<EndpointRTTResult> align_endpoint_delays(uint32_t target_rtt=0, uint32_t number_of_echoes=1) override;
 };
 
 } // namespace timing
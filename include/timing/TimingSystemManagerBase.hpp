@@ -13,6 +13,7 @@
  
 #include "TimingIssues.hpp"
 #include "timing/FMCIONode.hpp"
+#include "timing/TimestampSkewMonitor.hpp"
 
 // uHal Headers
 #include "uhal/DerivedNode.hpp"
@@ -80,6 +81,21 @@ public:
      */
     virtual void stopPartition(uint32_t partition_id) const = 0;
 
+    /**
+     * @brief      Configure and enable a group of timing system partitions
+     */
+    virtual void configurePartitions(const std::vector<uint32_t>& partition_ids, uint32_t trigger_mask, bool enableSpillGate) const = 0;
+
+    /**
+     * @brief      Start a group of timing system partitions together
+     */
+    virtual void startPartitions(const std::vector<uint32_t>& partition_ids) const = 0;
+
+    /**
+     * @brief      Stop a group of timing system partitions together
+     */
+    virtual void stopPartitions(const std::vector<uint32_t>& partition_ids) const = 0;
+
     /**
      * @brief      Read the current timestamp
      *
@@ -87,6 +103,13 @@ public:
      */
     virtual uint64_t read_master_timestamp() const = 0;
 
+    /**
+     * @brief      Timestamp readers for every board in the system, master first.
+     *
+     *             Intended for TimestampSkewMonitor.
+     */
+    virtual std::vector<TimestampSource> get_timestamp_sources() const = 0;
+
     /**
      * @brief      Measure the endpoint round trip time.
      *
@@ -101,16 +124,53 @@ public:
      */
     virtual uint64_t measure_endpoint_rtt(const ActiveEndpointConfig& ept_config) const = 0;
 
+    /**
+     * @brief      Measure the endpoint round trip time statistics over a series of echoes.
+     */
+    virtual RTTStatistics measure_endpoint_rtt_statistics(const ActiveEndpointConfig& ept_config, uint32_t number_of_echoes) const = 0;
+
     /**
      * @brief      Measure the round trip time for endpoints.
+     *
+     * @param[in]  number_of_echoes  Echoes per endpoint; the median of the accepted ones is used
+     */
+    virtual std::vector<EndpointRTTResult> performEndpointRTTScan(uint32_t number_of_echoes=1) = 0;
+
+    /**
+     * @brief      Order the expected endpoints for an RTT scan.
+     *
+     *             Endpoints are grouped by fanout and mux channel, so that each
+     *             mux channel is selected only once per scan.
      */
-    virtual std::vector<EndpointRTTResult> performEndpointRTTScan() = 0;
+    std::vector<ActiveEndpointConfig> plan_endpoint_rtt_scan() const;
 
     /**
      * @brief      Adjust the endpoint delays.
      */
     virtual void apply_endpoint_delays(uint32_t measure_rtt) const = 0;
 
+    /**
+     * @brief      Compute the endpoint delays that bring all round trip times to a common target.
+     *
+     *             The scan is assumed to have been taken with the delays of mExpectedEndpoints
+     *             applied. The target is raised to the largest measured round trip time if needed.
+     *             Only the coarse delay is solved for, as round trip times are measured in whole
+     *             clock cycles; fine and phase delays are kept.
+     *
+     * @param[in]  scan        Results of performEndpointRTTScan
+     * @param[in]  target_rtt  Target round trip time, in clock cycles
+     *
+     * @return     Endpoint configurations with the solved delays
+     */
+    std::vector<ActiveEndpointConfig> solve_endpoint_delays(const std::vector<EndpointRTTResult>& scan, uint32_t target_rtt=0) const;
+
+    /**
+     * @brief      Scan, solve and apply the endpoint delays, then verify with a second scan.
+     *
+     * @return     Results of the verification scan
+     */
+    virtual std::vector<EndpointRTTResult> align_endpoint_delays(uint32_t target_rtt=0, uint32_t number_of_echoes=1) = 0;
+
 protected:
 
     const std::string connectionsFile;
@@ -78,6 +78,21 @@ public:
      */
     void stopPartition(uint32_t partition_id) const override;
 
+    /**
+     * @brief      Configure and enable a group of timing system partitions
+     */
+    void configurePartitions(const std::vector<uint32_t>& partition_ids, uint32_t trigger_mask, bool enableSpillGate) const override;
+
+    /**
+     * @brief      Start a group of timing system partitions together
+     */
+    void startPartitions(const std::vector<uint32_t>& partition_ids) const override;
+
+    /**
+     * @brief      Stop a group of timing system partitions together
+     */
+    void stopPartitions(const std::vector<uint32_t>& partition_ids) const override;
+
     /**
      * @brief      Read the current timestamp
      *
@@ -85,6 +100,11 @@ public:
      */
     uint64_t read_master_timestamp() const override;
 
+    /**
+     * @brief      Timestamp readers for the masters, fanouts and endpoints.
+     */
+    std::vector<TimestampSource> get_timestamp_sources() const override;
+
     /**
      * @brief      Measure the endpoint round trip time.
      *
@@ -99,6 +119,11 @@ public:
      */
     virtual uint64_t measure_endpoint_rtt(uint32_t address, int32_t aFanout, uint32_t aMux) const;
 
+    /**
+     * @brief      Measure the endpoint round trip time statistics over a series of echoes.
+     */
+    virtual RTTStatistics measure_endpoint_rtt_statistics(uint32_t address, int32_t aFanout, uint32_t aMux, uint32_t number_of_echoes) const;
+
 
     /**
      * @brief      Measure the endpoint round trip time.
@@ -107,6 +132,20 @@ public:
      */
     uint64_t measure_endpoint_rtt(const ActiveEndpointConfig& ept_config) const override;
 
+    /**
+     * @brief      Measure the endpoint round trip time statistics over a series of echoes.
+     */
+    RTTStatistics measure_endpoint_rtt_statistics(const ActiveEndpointConfig& ept_config, uint32_t number_of_echoes) const override;
+
+    /**
+     * @brief      Measure the round trip time for endpoints.
+     *
+     *             Follows plan_endpoint_rtt_scan: each fanout mux channel is selected
+     *             once, and the next fanout's channel is selected ahead of time so it
+     *             settles while the current endpoints are measured.
+     */
+    std::vector<EndpointRTTResult> performEndpointRTTScan(uint32_t number_of_echoes=1) override;
+
 protected:
     std::vector<std::string> fanoutHardwareNames;
     std::vector<uhal::HwInterface> fanoutHardware;
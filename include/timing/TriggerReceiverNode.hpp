@@ -36,6 +36,11 @@ public:
      * @brief     Print the status of the timing node.
      */
     std::string get_status(bool print_out=false) const override;
+
+    /**
+     * @brief     Report the trigger receiver status to a sink.
+     */
+    void report_status(StatusSink& sink) const override;
     
     /**
      * @brief     Enable trigger rx endpoint
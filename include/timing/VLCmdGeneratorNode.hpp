@@ -19,6 +19,7 @@
 #include "uhal/DerivedNode.hpp"
 
 #include <string>
+#include <vector>
 
 namespace dunedaq {
 namespace timing {
@@ -46,6 +47,21 @@ public:
      * @brief     Adjust endpoint delay.
      */
     void apply_endpoint_delay(uint32_t address, uint32_t coarse_delay, uint32_t fine_delay, uint32_t phase_delay) const;
+
+    /**
+     * @brief     Adjust the delays of a set of endpoints in one pass.
+     *
+     *            Each command is sent as soon as the previous one is done. A
+     *            command is done once the done flag reads high after its go,
+     *            including in the packet that carries the go itself.
+     *
+     * @param[in] endpoints  Endpoint addresses and delays
+     * @param[in] timeout    Per-command timeout, in milliseconds
+     */
+    void apply_endpoint_delays(const std::vector<ActiveEndpointConfig>& endpoints, uint32_t timeout=100) const;
+
+private:
+    void queue_endpoint_delay(uint32_t address, uint32_t coarse_delay, uint32_t fine_delay, uint32_t phase_delay) const;
 };
 
 } // namespace timing
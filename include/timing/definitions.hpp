@@ -11,6 +11,7 @@
 #ifndef TIMING_INCLUDE_TIMING_DEFINITIONS_HPP_
 #define	TIMING_INCLUDE_TIMING_DEFINITIONS_HPP_
 
+#include <chrono>
 #include <map>
 #include <stdint.h>
 #include <string>
@@ -28,6 +29,7 @@ enum BoardRevision {kFMCRev1, kFMCRev2, kFMCRev3, kPC059Rev1, kTLURev1, kSIMRev1
 
 const uint32_t g_dune_sp_clock_in_hz = 50e6;
 const uint32_t g_event_size = 6;
+const uint32_t g_max_coarse_delay = 0x32;
 
 const std::map<BoardType, std::string> g_board_type_map = {
     {kBoardFMC, "fmc"},
@@ -181,19 +183,47 @@ struct ActiveEndpointConfig {
     }
 };
 
+struct RTTStatistics {
+    uint32_t samples;   // echoes sent
+    uint32_t accepted;  // echoes left after outlier rejection
+    uint64_t min;
+    uint64_t median;
+    uint64_t max;
+    double stddev;
+    bool unstable;
+};
+
+struct TimestampOffset {
+    uint32_t samples;                     // timestamp reads
+    int64_t offset;                       // timing minus host time, in clock ticks
+    uint64_t uncertainty;                 // half the shortest read round trip, in clock ticks
+    std::chrono::nanoseconds round_trip;  // shortest read round trip
+};
+
 struct EndpointRTTResult {
     std::string id;
     uint32_t adr;
     int32_t fanout;
     uint32_t mux;
     int32_t measuredRTT;
+    RTTStatistics statistics;
 
     EndpointRTTResult(ActiveEndpointConfig ept_config, uint32_t aMeasuredRTT) :
     id(ept_config.id),
     adr(ept_config.adr),
     fanout (ept_config.fanout),
     mux(ept_config.mux),
-    measuredRTT(aMeasuredRTT) {
+    measuredRTT(aMeasuredRTT),
+    statistics{1, 1, aMeasuredRTT, aMeasuredRTT, aMeasuredRTT, 0., false} {
+    }
+
+    EndpointRTTResult(ActiveEndpointConfig ept_config, const RTTStatistics& aStatistics) :
+    id(ept_config.id),
+    adr(ept_config.adr),
+    fanout (ept_config.fanout),
+    mux(ept_config.mux),
+    measuredRTT(aStatistics.median),
+    statistics(aStatistics) {
     }
 };
 
@@ -72,7 +72,7 @@ void FanoutDesign<IO,MST>::reset(uint32_t fanout_mode, const std::string& clock_
 	// 0 - fanout mode, outgoing data comes from sfp
 	// 1 - standalone mode, outgoing data comes from local master
 	uhal::Node::getNode("switch.csr.ctrl.master_src").write(fanout_mode);
-	uhal::Node::getClient().dispatch();
+	counted_dispatch(uhal::Node::getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -89,7 +89,7 @@ void FanoutDesign<IO,MST>::reset(uint32_t fanout_mode, const std::string& clock_
 template<class IO, class MST>
 uint32_t FanoutDesign<IO,MST>::measure_endpoint_rtt(uint32_t address, bool control_sfp, uint32_t sfp_mux) const {
 	auto lFanoutMode = uhal::Node::getNode("switch.csr.ctrl.master_src").read();
-	uhal::Node::getClient().dispatch();
+	counted_dispatch(uhal::Node::getClient());
 
 	if (!lFanoutMode.value()) {
 		std::ostringstream lMsg;
@@ -105,7 +105,7 @@ uint32_t FanoutDesign<IO,MST>::measure_endpoint_rtt(uint32_t address, bool contr
 template<class IO, class MST>
 void FanoutDesign<IO,MST>::apply_endpoint_delay(uint32_t address, uint32_t coarse_delay, uint32_t fine_delay, uint32_t phase_delay, bool measure_rtt, bool control_sfp, uint32_t sfp_mux) const {
 	auto lFanoutMode = uhal::Node::getNode("switch.csr.ctrl.master_src").read();
-	uhal::Node::getClient().dispatch();
+	counted_dispatch(uhal::Node::getClient());
 
 	if (!lFanoutMode.value()) {
 		std::ostringstream lMsg;
@@ -139,20 +139,26 @@ void MasterMuxDesign<IO,MST>::apply_endpoint_delay(uint32_t address, uint32_t co
 
 //-----------------------------------------------------------------------------
 template<class IO, class MST>
-std::vector<uint32_t> MasterMuxDesign<IO,MST>::scan_sfp_mux() const {
+std::vector<uint32_t> MasterMuxDesign<IO,MST>::scan_sfp_mux(uint32_t lock_timeout) const {
 	std::vector<uint32_t> lLockedChannels;
     
-    // TODO will this be right for every fanout board, need to check the IO board
-    uint32_t lNumberOfMuxChannels = 8;
+    uint32_t lNumberOfMuxChannels = this->get_io_node().get_number_of_sfp_mux_channels();
+    uint32_t lLOSFlags = this->get_io_node().read_sfp_los_flags();
+    
     for (uint32_t i=0; i < lNumberOfMuxChannels; ++i) {
+    	if ((lLOSFlags >> i) & 0x1) {
+    		TLOG_DEBUG(0) << "Slot " << i << " no signal";
+    		continue;
+    	}
     	TLOG_DEBUG(0) << "Scanning slot " << i;
 
+    	this->get_io_node().switch_sfp_mux_channel(i);
     	try {
-    		this->switch_sfp_mux_channel(i, true);	
-    	} catch(...) {
+    		this->get_master_node().enable_upstream_endpoint(lock_timeout);
+    	} catch(const UpstreamEndpointFailedToLock& e) {
     		TLOG_DEBUG(0) << "Slot " << i << " not locked";
+    		continue;
     	}
-    	// TODO catch right except
     	
   		TLOG_DEBUG(0) << "Slot " << i << " locked";
   		lLockedChannels.push_back(i);		
@@ -107,6 +107,29 @@ void TimingSystemManager<MST_TOP,EPT_TOP>::stopPartition(uint32_t partition_id)
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP>
+void TimingSystemManager<MST_TOP,EPT_TOP>::configurePartitions(const std::vector<uint32_t>& partition_ids, uint32_t trigger_mask, bool enableSpillGate) const {
+	getMaster(0).get_master_node().configure_partitions(partition_ids, trigger_mask, enableSpillGate);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP>
+void TimingSystemManager<MST_TOP,EPT_TOP>::startPartitions(const std::vector<uint32_t>& partition_ids) const {
+	getMaster(0).get_master_node().start_partitions(partition_ids);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP>
+void TimingSystemManager<MST_TOP,EPT_TOP>::stopPartitions(const std::vector<uint32_t>& partition_ids) const {
+	getMaster(0).get_master_node().stop_partitions(partition_ids);
+}
+//-----------------------------------------------------------------------------
+
 
 //-----------------------------------------------------------------------------
 template<class MST_TOP, class EPT_TOP>
@@ -116,6 +139,25 @@ uint64_t TimingSystemManager<MST_TOP,EPT_TOP>::read_master_timestamp() const {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP>
+std::vector<TimestampSource> TimingSystemManager<MST_TOP,EPT_TOP>::get_timestamp_sources() const {
+	std::vector<TimestampSource> lSources;
+
+	for (uint32_t i = 0; i < getNumberOfMasters(); ++i) {
+		auto& lMaster = getMaster(i).get_master_node();
+		lSources.push_back({masterHardwareNames.at(i), [&lMaster]() { return lMaster.read_timestamp(); }});
+	}
+
+	for (uint32_t i = 0; i < getNumberOfEndpoints(); ++i) {
+		auto& lEndpoint = getEndpoint(i).get_endpoint_node(0);
+		lSources.push_back({endpointHardwareNames.at(i), [&lEndpoint]() { return lEndpoint.read_timestamp(); }});
+	}
+	return lSources;
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 template<class MST_TOP, class EPT_TOP>
 uint64_t TimingSystemManager<MST_TOP,EPT_TOP>::measure_endpoint_rtt(uint32_t address) const {
@@ -127,6 +169,14 @@ uint64_t TimingSystemManager<MST_TOP,EPT_TOP>::measure_endpoint_rtt(uint32_t add
 //-----------------------------------------------------------------------------
 template<class MST_TOP, class EPT_TOP>
 uint64_t TimingSystemManager<MST_TOP,EPT_TOP>::measure_endpoint_rtt(const ActiveEndpointConfig& ept_config) const {
+	return measure_endpoint_rtt_statistics(ept_config, 1).median;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP>
+RTTStatistics TimingSystemManager<MST_TOP,EPT_TOP>::measure_endpoint_rtt_statistics(const ActiveEndpointConfig& ept_config, uint32_t number_of_echoes) const {
 	uint32_t lEptAdr = ept_config.adr;
 	uint32_t lEptFanout = ept_config.fanout;
 	
@@ -135,24 +185,29 @@ uint64_t TimingSystemManager<MST_TOP,EPT_TOP>::measure_endpoint_rtt(const Active
 		TLOG() << "Endpoint config contains an fanout ept mux value. This is a system without fanouts";
 	}
 
-	return getMaster(0).get_master_node().measure_endpoint_rtt(lEptAdr);
+	return getMaster(0).get_master_node().measure_endpoint_rtt_statistics(lEptAdr, number_of_echoes);
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
 template<class MST_TOP, class EPT_TOP>
-std::vector<EndpointRTTResult> TimingSystemManager<MST_TOP,EPT_TOP>::performEndpointRTTScan() {
+std::vector<EndpointRTTResult> TimingSystemManager<MST_TOP,EPT_TOP>::performEndpointRTTScan(uint32_t number_of_echoes) {
 
+	auto lStart = std::chrono::steady_clock::now();
 	std::vector<EndpointRTTResult> lEndpointResults;
 
-	for (auto it = this->mExpectedEndpoints.begin(); it != this->mExpectedEndpoints.end(); ++it) {
-		uint32_t lRTT = this->measure_endpoint_rtt(it->second);
+	for (auto& lEpt : this->plan_endpoint_rtt_scan()) {
+		RTTStatistics lRTT = this->measure_endpoint_rtt_statistics(lEpt, number_of_echoes);
 		
-		if (lRTT > this->mMaxMeasuredRTT) this->mMaxMeasuredRTT = lRTT;
+		if (lRTT.unstable) TLOG() << lEpt.id << " RTT unstable, median " << lRTT.median << " stddev " << lRTT.stddev;
+		if (lRTT.median > this->mMaxMeasuredRTT) this->mMaxMeasuredRTT = lRTT.median;
 		
-		lEndpointResults.push_back(EndpointRTTResult(it->second, lRTT));
+		lEndpointResults.push_back(EndpointRTTResult(lEpt, lRTT));
 	}
+
+	auto lElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - lStart);
+	TLOG() << "RTT scan of " << lEndpointResults.size() << " endpoints took " << lElapsed.count() << " ms";
 	return lEndpointResults;
 }
 //-----------------------------------------------------------------------------
@@ -182,4 +237,30 @@ void TimingSystemManager<MST_TOP,EPT_TOP>::apply_endpoint_delays(uint32_t measur
 }
 //-----------------------------------------------------------------------------
 
+
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP>
+std::vector<EndpointRTTResult> TimingSystemManager<MST_TOP,EPT_TOP>::align_endpoint_delays(uint32_t target_rtt, uint32_t number_of_echoes) {
+
+	this->mMaxMeasuredRTT = 0;
+	auto lScan = this->performEndpointRTTScan(number_of_echoes);
+	auto lConfigs = this->solve_endpoint_delays(lScan, target_rtt);
+	const uint32_t lTarget = std::max(target_rtt, this->mMaxMeasuredRTT);
+
+	getMaster(0).get_master_node().apply_endpoint_delays(lConfigs);
+	for (auto& lConfig : lConfigs) this->mExpectedEndpoints.at(lConfig.id) = lConfig;
+
+	// Verify
+	this->mMaxMeasuredRTT = 0;
+	auto lVerification = this->performEndpointRTTScan(number_of_echoes);
+
+	for (auto& lResult : lVerification) {
+		if (lResult.measuredRTT != static_cast<int32_t>(lTarget)) {
+			TLOG() << lResult.id << " RTT " << lResult.measuredRTT << " after alignment, expected " << lTarget;
+		}
+	}
+	return lVerification;
+}
+//-----------------------------------------------------------------------------
+
 }
\ No newline at end of file
@@ -104,6 +104,29 @@ void TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::stopPartition(uint3
 }
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP, class FAN_TOP>
+void TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::configurePartitions(const std::vector<uint32_t>& partition_ids, uint32_t trigger_mask, bool enableSpillGate) const {
+	this->getMaster(0).get_master_node().configure_partitions(partition_ids, trigger_mask, enableSpillGate);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP, class FAN_TOP>
+void TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::startPartitions(const std::vector<uint32_t>& partition_ids) const {
+	this->getMaster(0).get_master_node().start_partitions(partition_ids);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP, class FAN_TOP>
+void TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::stopPartitions(const std::vector<uint32_t>& partition_ids) const {
+	this->getMaster(0).get_master_node().stop_partitions(partition_ids);
+}
+//-----------------------------------------------------------------------------
+
 
 //-----------------------------------------------------------------------------
 template<class MST_TOP, class EPT_TOP, class FAN_TOP>
@@ -113,11 +136,36 @@ uint64_t TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::read_master_tim
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP, class FAN_TOP>
+std::vector<TimestampSource> TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::get_timestamp_sources() const {
+	std::vector<TimestampSource> lSources = TimingSystemManager<MST_TOP,EPT_TOP>::get_timestamp_sources();
+
+	// Fanouts go between the masters and the endpoints
+	std::vector<TimestampSource> lFanoutSources;
+	for (uint32_t i = 0; i < getNumberOfFanouts(); ++i) {
+		auto& lFanoutMaster = getFanout(i).get_master_node();
+		lFanoutSources.push_back({fanoutHardwareNames.at(i), [&lFanoutMaster]() { return lFanoutMaster.read_timestamp(); }});
+	}
+	lSources.insert(lSources.begin() + this->getNumberOfMasters(), lFanoutSources.begin(), lFanoutSources.end());
+	return lSources;
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 template<class MST_TOP, class EPT_TOP, class FAN_TOP>
 uint64_t TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::measure_endpoint_rtt(uint32_t address, int32_t aFanout, uint32_t aMux) const {
+	return this->measure_endpoint_rtt_statistics(address, aFanout, aMux, 1).median;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP, class FAN_TOP>
+RTTStatistics TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::measure_endpoint_rtt_statistics(uint32_t address, int32_t aFanout, uint32_t aMux, uint32_t number_of_echoes) const {
 	
-	uint32_t lRTT;
+	RTTStatistics lRTT;
 		
 	this->getMaster(0).get_master_node().switch_endpoint_sfp(0x0, false);
 	this->getMaster(0).get_master_node().switch_endpoint_sfp(address, true);
@@ -128,7 +176,7 @@ uint64_t TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::measure_endpoin
 	if (aFanout >= 0) getFanout(aFanout).switch_sfp_mux_channel(aMux, true);
 		
 	// gets master rtt ept in a good state, and sends echo command (due to second argument endpoint sfp is not controlled in this call, already done above)
-	lRTT = this->getMaster(0).get_master_node().measure_endpoint_rtt(address, false);
+	lRTT = this->getMaster(0).get_master_node().measure_endpoint_rtt_statistics(address, number_of_echoes, false);
 
 	this->getMaster(0).get_master_node().switch_endpoint_sfp(address, false);
 		
@@ -156,4 +204,69 @@ uint64_t TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::measure_endpoin
 }
 //-----------------------------------------------------------------------------
 
+
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP, class FAN_TOP>
+RTTStatistics TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::measure_endpoint_rtt_statistics(const ActiveEndpointConfig& ept_config, uint32_t number_of_echoes) const {
+	return this->measure_endpoint_rtt_statistics(ept_config.adr, ept_config.fanout, ept_config.mux, number_of_echoes);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<class MST_TOP, class EPT_TOP, class FAN_TOP>
+std::vector<EndpointRTTResult> TimingSystemWithFanoutManager<MST_TOP,EPT_TOP,FAN_TOP>::performEndpointRTTScan(uint32_t number_of_echoes) {
+
+	auto lStart = std::chrono::steady_clock::now();
+	const auto& lMaster = this->getMaster(0).get_master_node();
+
+	std::vector<ActiveEndpointConfig> lPlan = this->plan_endpoint_rtt_scan();
+	std::vector<EndpointRTTResult> lEndpointResults;
+
+	// mux channel currently selected on each fanout
+	std::map<int32_t, uint32_t> lSelectedMux;
+	uint32_t lMuxSwitches = 0;
+
+	auto lSelectMux = [&](int32_t aFanout, uint32_t aMux) {
+		auto lSelected = lSelectedMux.find(aFanout);
+		if (lSelected != lSelectedMux.end() && lSelected->second == aMux) return;
+
+		getFanout(aFanout).switch_sfp_mux_channel(aMux, false);
+		lSelectedMux[aFanout] = aMux;
+		++lMuxSwitches;
+	};
+
+	// Each endpoint tx is switched back off after its measurement, so one broadcast is enough
+	lMaster.switch_endpoint_sfp(0x0, false);
+
+	for (auto it = lPlan.begin(); it != lPlan.end(); ++it) {
+		lMaster.switch_endpoint_sfp(it->adr, true);
+
+		if (it->fanout >= 0) {
+			lSelectMux(it->fanout, it->mux);
+			
+			// Select the channel of the next fanout in the plan now, it is not used before then
+			auto lNext = std::find_if(it+1, lPlan.end(), [it](const ActiveEndpointConfig& e) { return e.fanout >= 0 && e.fanout != it->fanout; });
+			if (lNext != lPlan.end()) lSelectMux(lNext->fanout, lNext->mux);
+
+			// wait for fanout rtt ept to be in a good state
+			getFanout(it->fanout).get_master_node().enable_upstream_endpoint();
+		}
+
+		RTTStatistics lRTT = lMaster.measure_endpoint_rtt_statistics(it->adr, number_of_echoes, false);
+
+		lMaster.switch_endpoint_sfp(it->adr, false);
+
+		if (lRTT.unstable) TLOG() << it->id << " RTT unstable, median " << lRTT.median << " stddev " << lRTT.stddev;
+		if (lRTT.median > this->mMaxMeasuredRTT) this->mMaxMeasuredRTT = lRTT.median;
+
+		lEndpointResults.push_back(EndpointRTTResult(*it, lRTT));
+	}
+
+	auto lElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - lStart);
+	TLOG() << "RTT scan of " << lEndpointResults.size() << " endpoints took " << lElapsed.count() << " ms, " << lMuxSwitches << " mux switches";
+	return lEndpointResults;
+}
+//-----------------------------------------------------------------------------
+
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+#include <thread>
+
 namespace dunedaq::timing {
 
 
@@ -139,22 +142,29 @@ format_reg_value(std::string regValue, uint32_t /*base*/) {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+template <>
+inline std::string
+format_reg_value(uint32_t regValue, uint32_t base) {
+    return format_unsigned_value(regValue, base);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template <>
+inline std::string
+format_reg_value(uint64_t regValue, uint32_t base) {
+    return format_unsigned_value(regValue, base);
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 template <>
 inline std::string
 format_reg_value(uhal::ValWord<uint32_t> regValue, uint32_t base) {
-    std::stringstream lValueStream;
-    if (base == 16) {
-        lValueStream << std::showbase << std::hex;
-    } else if (base == 10) {
-        lValueStream << std::dec;
-    } else {
-        // TODO warning?
-        TLOG() << "format_reg_value: unsupported number base: " << base;
-        lValueStream << std::dec;
-    }
-    lValueStream << regValue.value();
-    return lValueStream.str();
+    return format_unsigned_value(regValue.value(), base);
 }
 //-----------------------------------------------------------------------------
 
@@ -163,38 +173,50 @@ format_reg_value(uhal::ValWord<uint32_t> regValue, uint32_t base) {
 template<class T>
 std::string
 format_reg_table(T data, std::string title, std::vector<std::string> headers) {
-  
-  uint32_t lTableWidth = 7;
-  uint32_t lRegColumnWidth = 0;
-  uint32_t lValColumnWidth = 3;
-  std::stringstream lTableStream;
+
+  // Format every value once, measuring the columns on the way
+  std::vector<std::string> lValues;
+  uint32_t lRegColumnWidth = headers.at(0).size();
+  uint32_t lValColumnWidth = std::max<uint32_t>(3, headers.at(1).size());
 
   for (auto it=data.begin(); it!=data.end(); ++it) {
-    lRegColumnWidth = lRegColumnWidth > it->first.size() ? lRegColumnWidth : it->first.size();
-    lValColumnWidth = lValColumnWidth > format_reg_value(it->second).size() ? lValColumnWidth : format_reg_value(it->second).size();
+    lValues.push_back(format_reg_value(it->second));
+    lRegColumnWidth = std::max<uint32_t>(lRegColumnWidth, it->first.size());
+    lValColumnWidth = std::max<uint32_t>(lValColumnWidth, lValues.back().size());
   }
 
-  // header vector length check
-  lRegColumnWidth = lRegColumnWidth > headers.at(0).size() ? lRegColumnWidth : headers.at(0).size();
-  lValColumnWidth = lValColumnWidth > headers.at(1).size() ? lValColumnWidth : headers.at(1).size();
-  
-  lTableWidth = lTableWidth + lRegColumnWidth + lValColumnWidth;
+  const uint32_t lTableWidth = 7 + lRegColumnWidth + lValColumnWidth;
+  const std::string lBorder = "+-" + std::string(lRegColumnWidth, '-') + "-+-" + std::string(lValColumnWidth, '-') + "-+\n";
+
+  std::string lTable;
+  lTable.reserve((lValues.size() + 5) * (lTableWidth + 1) + title.size());
+
+  auto lAppendRow = [&](const std::string& aRegister, const std::string& aValue) {
+    lTable += "| ";
+    append_centred(lTable, aRegister, lRegColumnWidth);
+    lTable += " | ";
+    append_centred(lTable, aValue, lValColumnWidth);
+    lTable += " |\n";
+  };
+
+  if (title.size()) {
+    append_centred(lTable, title, lTableWidth, '-');
+    lTable += '\n';
+  }
 
-  if (title.size()) lTableStream << boost::format("%=s\n") % boost::io::group(std::setw(lTableWidth), std::setfill('-'), title);
-  
   if (headers.at(0).size() || headers.at(1).size()) {
-    lTableStream << boost::format("+-%=s-+-%=s-+\n") % boost::io::group(std::setw(lRegColumnWidth), std::setfill('-'), "")  % boost::io::group(std::setw(lValColumnWidth), std::setfill('-'), "");
-    lTableStream << boost::format("| %=s | %=s |\n") % boost::io::group(std::setw(lRegColumnWidth), headers.at(0)) % boost::io::group(std::setw(lValColumnWidth), headers.at(1));
+    lTable += lBorder;
+    lAppendRow(headers.at(0), headers.at(1));
   }
-  
-  lTableStream << boost::format("+-%=s-+-%=s-+\n") % boost::io::group(std::setw(lRegColumnWidth), std::setfill('-'), "")  % boost::io::group(std::setw(lValColumnWidth), std::setfill('-'), "");
 
-  for (auto it=data.begin(); it!=data.end(); ++it) {
-    lTableStream << boost::format("| %=s | %=s |\n") % boost::io::group(std::setw(lRegColumnWidth), it->first) % boost::io::group(std::setw(lValColumnWidth), format_reg_value(it->second));
+  lTable += lBorder;
+  auto lValue = lValues.begin();
+  for (auto it=data.begin(); it!=data.end(); ++it, ++lValue) {
+    lAppendRow(it->first, *lValue);
   }
-  lTableStream << boost::format("+-%=s-+-%=s-+\n") % boost::io::group(std::setw(lRegColumnWidth), std::setfill('-'), "")  % boost::io::group(std::setw(lValColumnWidth), std::setfill('-'), "");
+  lTable += lBorder;
 
-  return lTableStream.str();
+  return lTable;
 }
 //-----------------------------------------------------------------------------
 
@@ -203,153 +225,125 @@ template<class T>
 std::string format_counters_table(std::vector<T> aCounterNodes, std::vector<std::string> aCounterNodeTitles, std::string aTableTitle, std::vector<std::string> aCounterLabels, std::string aCounterLabelsHeader) {
 
   uint32_t lCounterNodesNumber = aCounterNodes.size();
-  uint32_t lTableWidth = 4+(lCounterNodesNumber*3);
 
   std::vector<std::string> lCounterNodeTitles;
 
   if (!aCounterNodeTitles.size()) {
-    for (uint32_t i=0; i < aCounterNodes.size(); ++i) {
-      lCounterNodeTitles.push_back("Counters");
-    }
+    lCounterNodeTitles.assign(lCounterNodesNumber, "Counters");
   } else if (aCounterNodes.size() != aCounterNodeTitles.size()) {
     throw FormatCountersTableNodesTitlesMismatch(ERS_HERE);
   } else {
     lCounterNodeTitles = aCounterNodeTitles;
   }
 
-  uint32_t lCounterNumber;
-  uint32_t lCounterLabelColumnWidth = 0;
-
-  std::stringstream lTableStream;
-
   std::vector<std::string> lCounterLabels;
   if (aCounterLabels.size()) {
     lCounterLabels = aCounterLabels;
   } else {
     for (auto it=g_command_map.begin(); it != g_command_map.end(); ++it) lCounterLabels.push_back(it->second);
   }
-  lCounterNumber = lCounterLabels.size();
+  uint32_t lCounterNumber = lCounterLabels.size();
 
+  uint32_t lCounterLabelColumnWidth = aCounterLabelsHeader.size();
   for (auto it=lCounterLabels.begin(); it != lCounterLabels.end(); ++it) {
-    lCounterLabelColumnWidth = lCounterLabelColumnWidth > it->size() ? lCounterLabelColumnWidth : it->size();
+    lCounterLabelColumnWidth = std::max<uint32_t>(lCounterLabelColumnWidth, it->size());
   }
-  lCounterLabelColumnWidth = lCounterLabelColumnWidth > aCounterLabelsHeader.size() ? lCounterLabelColumnWidth : aCounterLabelsHeader.size();
-
-  typedef std::vector<std::pair<std::string, std::string>> CounterValuesContainer;
-
-  std::vector<CounterValuesContainer> lCounterValueContainers;
-  std::vector<std::pair<uint32_t, uint32_t>> lCounterValueColumnWidths;
-
-  for (auto nodeIt=aCounterNodes.begin(); nodeIt!=aCounterNodes.end(); ++nodeIt) {
-
-    CounterValuesContainer lCounterValues;
-
-    uint32_t lCounterValueDecColumnWidth = 5;
-    uint32_t lCounterValueHexColumnWidth = 5;
-
-    for (auto counterIt=nodeIt->begin(); counterIt != nodeIt->end(); ++counterIt) {
 
-      std::string lCounterValueDec = format_reg_value(*counterIt,10);
-      std::string lCounterValueHex = format_reg_value(*counterIt,16);
+  // Format every counter once, in decimal and hex, measuring the columns on the way
+  std::vector<std::vector<std::string>> lDecValues(lCounterNodesNumber);
+  std::vector<std::vector<std::string>> lHexValues(lCounterNodesNumber);
+  std::vector<uint32_t> lDecWidths(lCounterNodesNumber, 5);
+  std::vector<uint32_t> lHexWidths(lCounterNodesNumber, 5);
 
-      lCounterValueDecColumnWidth = lCounterValueDecColumnWidth > lCounterValueDec.size() ? lCounterValueDecColumnWidth : lCounterValueDec.size();
-      lCounterValueHexColumnWidth = lCounterValueHexColumnWidth > lCounterValueHex.size() ? lCounterValueHexColumnWidth : lCounterValueHex.size();
-
-      lCounterValues.push_back(std::make_pair(lCounterValueDec, lCounterValueHex));
+  for (uint32_t j=0; j < lCounterNodesNumber; ++j) {
+    for (auto counterIt=aCounterNodes.at(j).begin(); counterIt != aCounterNodes.at(j).end(); ++counterIt) {
+      lDecValues.at(j).push_back(format_reg_value(*counterIt, 10));
+      lHexValues.at(j).push_back(format_reg_value(*counterIt, 16));
+      lDecWidths.at(j) = std::max<uint32_t>(lDecWidths.at(j), lDecValues.at(j).back().size());
+      lHexWidths.at(j) = std::max<uint32_t>(lHexWidths.at(j), lHexValues.at(j).back().size());
     }
-
-    lCounterValueContainers.push_back(lCounterValues);
-    lCounterValueColumnWidths.push_back(std::make_pair(lCounterValueDecColumnWidth, lCounterValueHexColumnWidth));
   }
 
+  // A node title wider than its two columns widens both of them
   std::vector<uint32_t> lCounterNodeTitleSizes;
-  // titles and border
-  std::stringstream lCounterTitlesRow;
-  lCounterTitlesRow << boost::format("| %=s |") % boost::io::group(std::setw(lCounterLabelColumnWidth), "");
-  lTableWidth = lTableWidth + lCounterLabelColumnWidth;
-  for (uint32_t i=0; i < lCounterNodesNumber; ++i) {
-    uint32_t lDecWidth = lCounterValueColumnWidths.at(i).first;
-    uint32_t lHexWidth = lCounterValueColumnWidths.at(i).second;
-
-    uint32_t lCounterTitleSize = lCounterNodeTitles.at(i).size();
-
-    if (lCounterTitleSize > (lDecWidth+lHexWidth+3)) {
+  uint32_t lTableWidth = 4 + (lCounterNodesNumber*3) + lCounterLabelColumnWidth;
+  for (uint32_t j=0; j < lCounterNodesNumber; ++j) {
+    uint32_t lCounterTitleSize = lCounterNodeTitles.at(j).size();
 
+    if (lCounterTitleSize > (lDecWidths.at(j)+lHexWidths.at(j)+3)) {
       if ((lCounterTitleSize-3)%2) ++lCounterTitleSize;
-      
-      lCounterValueColumnWidths.at(i).first  = (lCounterTitleSize-3)/2;
-      lCounterValueColumnWidths.at(i).second = (lCounterTitleSize-3)/2;
-  
+      lDecWidths.at(j) = (lCounterTitleSize-3)/2;
+      lHexWidths.at(j) = (lCounterTitleSize-3)/2;
     } else {
-      lCounterTitleSize = (lDecWidth+lHexWidth+3);
+      lCounterTitleSize = lDecWidths.at(j)+lHexWidths.at(j)+3;
     }
-    lCounterTitlesRow << boost::format(" %=s |") % boost::io::group(std::setw(lCounterTitleSize), lCounterNodeTitles.at(i));
     lCounterNodeTitleSizes.push_back(lCounterTitleSize);
-    lTableWidth = lTableWidth + lCounterTitleSize;
+    lTableWidth += lCounterTitleSize;
   }
-  lCounterTitlesRow << std::endl;
-  
-  std::stringstream lTitleRowBorder;
-  lTitleRowBorder << boost::format("+-%=s-+") % boost::io::group(std::setw(lCounterLabelColumnWidth), std::setfill('-'), "");
-  for (uint32_t i=0; i < lCounterNodesNumber; ++i) {
-    lTitleRowBorder << boost::format("-%=s-+") % boost::io::group(std::setw(lCounterNodeTitleSizes.at(i)), std::setfill('-'), "");
+
+  std::string lTitleRowBorder = "+-" + std::string(lCounterLabelColumnWidth, '-') + "-+";
+  std::string lRowBorder = lTitleRowBorder;
+  for (uint32_t j=0; j < lCounterNodesNumber; ++j) {
+    lTitleRowBorder += "-" + std::string(lCounterNodeTitleSizes.at(j), '-') + "-+";
+    lRowBorder += "-" + std::string(lDecWidths.at(j), '-') + "-+-" + std::string(lHexWidths.at(j), '-') + "-+";
   }
-  lTitleRowBorder << std::endl;
+  lTitleRowBorder += '\n';
+  lRowBorder += '\n';
 
-  if (aTableTitle.size()) lTableStream << boost::format("%=s\n") % boost::io::group(std::setw(lTableWidth), std::setfill('-'), aTableTitle);
+  std::string lTable;
+  lTable.reserve((lCounterNumber + 6) * (lTableWidth + 1) + aTableTitle.size());
 
-  lTableStream << lTitleRowBorder.str();
-  lTableStream << lCounterTitlesRow.str();
-  lTableStream << lTitleRowBorder.str();
-  //
+  // titles and border
+  if (aTableTitle.size()) {
+    append_centred(lTable, aTableTitle, lTableWidth, '-');
+    lTable += '\n';
+  }
 
-  // headers
-  std::stringstream lCounterHeaders;
-  lCounterHeaders << boost::format("| %=s |") % boost::io::group(std::setw(lCounterLabelColumnWidth), aCounterLabelsHeader);
+  lTable += lTitleRowBorder;
+  lTable += "| ";
+  append_centred(lTable, "", lCounterLabelColumnWidth);
+  lTable += " |";
   for (uint32_t j=0; j < lCounterNodesNumber; ++j) {
-      uint32_t lDecWidth = lCounterValueColumnWidths.at(j).first;
-      uint32_t lHexWidth = lCounterValueColumnWidths.at(j).second;
-      lCounterHeaders << boost::format(" %=s | %=s |") % boost::io::group(std::setw(lDecWidth), "cnts") % boost::io::group(std::setw(lHexWidth), "hex");
+    lTable += ' ';
+    append_centred(lTable, lCounterNodeTitles.at(j), lCounterNodeTitleSizes.at(j));
+    lTable += " |";
   }
-  lTableStream << lCounterHeaders.str() << std::endl;
-  //
+  lTable += '\n';
+  lTable += lTitleRowBorder;
 
-  // top counter row border
-  std::stringstream lRowBorder;
-  lRowBorder << boost::format("+-%=s-+") % boost::io::group(std::setw(lCounterLabelColumnWidth), std::setfill('-'), "");
+  // headers
+  lTable += "| ";
+  append_centred(lTable, aCounterLabelsHeader, lCounterLabelColumnWidth);
+  lTable += " |";
   for (uint32_t j=0; j < lCounterNodesNumber; ++j) {
-      uint32_t lDecWidth = lCounterValueColumnWidths.at(j).first;
-      uint32_t lHexWidth = lCounterValueColumnWidths.at(j).second;
-      lRowBorder << boost::format("-%=s-+-%=s-+") % boost::io::group(std::setw(lDecWidth), std::setfill('-'), "")  % boost::io::group(std::setw(lHexWidth), std::setfill('-'), "");
-    }
-  lRowBorder << std::endl;
-  lTableStream << lRowBorder.str();
-  //
+    lTable += ' ';
+    append_centred(lTable, "cnts", lDecWidths.at(j));
+    lTable += " | ";
+    append_centred(lTable, "hex", lHexWidths.at(j));
+    lTable += " |";
+  }
+  lTable += '\n';
+  lTable += lRowBorder;
 
   // counter rows
   for (uint32_t i=0; i < lCounterNumber; ++i) {
-    std::stringstream lTableRowStream;
-
-    lTableRowStream << boost::format("| %=s |") % boost::io::group(std::setw(lCounterLabelColumnWidth), lCounterLabels.at(i));
-
+    lTable += "| ";
+    append_centred(lTable, lCounterLabels.at(i), lCounterLabelColumnWidth);
+    lTable += " |";
     for (uint32_t j=0; j < lCounterNodesNumber; ++j) {
-      uint32_t lDecWidth = lCounterValueColumnWidths.at(j).first;
-      uint32_t lHexWidth = lCounterValueColumnWidths.at(j).second;
-
-      std::string lDecValue = lCounterValueContainers.at(j).at(i).first;
-      std::string lHexValue = lCounterValueContainers.at(j).at(i).second;
-
-      lTableRowStream << boost::format(" %=s | %=s |") % boost::io::group(std::setw(lDecWidth), lDecValue) % boost::io::group(std::setw(lHexWidth), lHexValue);
-
+      lTable += ' ';
+      append_centred(lTable, lDecValues.at(j).at(i), lDecWidths.at(j));
+      lTable += " | ";
+      append_centred(lTable, lHexValues.at(j).at(i), lHexWidths.at(j));
+      lTable += " |";
     }
-    lTableStream << lTableRowStream.str() << std::endl;
+    lTable += '\n';
   }
-  //
 
   // bottom counter row border
-  lTableStream << lRowBorder.str();
-  
-  return lTableStream.str();
+  lTable += lRowBorder;
+
+  return lTable;
 }
 //-----------------------------------------------------------------------------
 
@@ -421,6 +415,31 @@ std::string short_vec_fmt(const std::vector<T>& aVec)
   return oss.str();
 }
 //-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<typename F>
+PollResult
+poll_until(F&& aCondition, std::chrono::microseconds aTimeout, uint32_t aSpinPolls, std::chrono::microseconds aMaxSleep) {
+
+  const auto lStart = std::chrono::steady_clock::now();
+  std::chrono::microseconds lSleep(std::min(std::chrono::microseconds(50), aMaxSleep));
+
+  for (uint32_t lPolls(1);; ++lPolls) {
+    bool lDone = aCondition();
+    auto lElapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - lStart);
+
+    if (lDone || lElapsed >= aTimeout) {
+      return {lDone, lPolls, lElapsed};
+    }
+
+    if (lPolls < aSpinPolls) continue;
+
+    std::this_thread::sleep_for(std::min(lSleep, aTimeout - lElapsed));
+    lSleep = std::min(lSleep * 2, aMaxSleep);
+  }
+}
+//-----------------------------------------------------------------------------
 } // namespace dunedaq::timing
 
 
@@ -26,12 +26,11 @@
 #include <boost/type_traits/is_signed.hpp>
 #include <boost/type_traits/is_unsigned.hpp>
 #include <boost/unordered_map.hpp>
-#include <boost/format.hpp>
-#include <boost/format/group.hpp>
 
 // C++ Headers
 #include <string>
 #include <istream>
+#include <sstream>
 #include <iomanip>
 #include <stdint.h>
 #include <stdlib.h>
@@ -70,6 +69,32 @@ Snapshot snapshot(const uhal::Node& node, const std::string& aRegex);
  */
 void millisleep(const double& aTimeInMilliseconds);
 
+/**
+ * @brief      Outcome of a poll_until call
+ */
+struct PollResult {
+    bool success;
+    uint32_t polls;
+    std::chrono::microseconds elapsed;
+};
+
+/**
+ * @brief      Evaluates a condition until it holds or the timeout expires.
+ *
+ *             The condition is evaluated back to back for the first aSpinPolls
+ *             calls, then with an exponentially growing sleep capped at aMaxSleep.
+ *             It is always evaluated at least once.
+ *
+ * @param      aCondition   Callable returning true when done; typically reads and dispatches
+ * @param[in]  aTimeout     Time budget
+ * @param[in]  aSpinPolls   Number of evaluations before sleeping
+ * @param[in]  aMaxSleep    Upper bound of the sleep between evaluations
+ *
+ * @return     Whether the condition was met, number of evaluations and time elapsed
+ */
+template<typename F>
+PollResult poll_until(F&& aCondition, std::chrono::microseconds aTimeout, uint32_t aSpinPolls=8, std::chrono::microseconds aMaxSleep=std::chrono::milliseconds(10));
+
 /**
  * Formats a std::string in printf fashion
  *
@@ -134,6 +159,16 @@ uint64_t tstamp2int(uhal::ValVector< uint32_t > rawTimestamp);
 template <class T>
 std::string format_reg_value(T regValue, uint32_t base=16);
 
+/**
+ * @brief      Format an unsigned value as format_reg_value does, without a stream
+ */
+std::string format_unsigned_value(uint64_t aValue, uint32_t aBase=16);
+
+/**
+ * @brief      Append a string centred in a field, padded as boost::format("%=s") does
+ */
+void append_centred(std::string& aOut, const std::string& aText, uint32_t aWidth, char aFill=' ');
+
 /**
  * @brief     Format reg-value table
  * @return 
@@ -147,6 +182,11 @@ std::string format_reg_table(T data, std::string title="", std::vector<std::stri
  */
 int64_t get_seconds_since_epoch();
 
+/**
+ * @brief      Convert a host time to a timing timestamp, with clock tick resolution
+ */
+uint64_t host_time_to_timestamp(std::chrono::system_clock::time_point aTime);
+
 /**
  * ""
  * @return 
@@ -174,6 +214,37 @@ std::string format_counters_table(std::vector<T> aCounters, std::vector<std::str
 double convert_bits_to_float(uint64_t aBits, bool aIsDoublePrecision=false);
 
 
+/**
+ * @brief      Summarise a set of round-trip time samples.
+ *
+ *             Samples further than 3 scaled median absolute deviations, and
+ *             at least aMaxSpread, from the median are rejected. The link is
+ *             flagged unstable if the accepted samples spread over more than
+ *             aMaxSpread, or if more than a fifth of the samples are rejected.
+ *
+ * @param[in]  aSamples    Round-trip times, in clock ticks
+ * @param[in]  aMaxSpread  Tolerated spread, in clock ticks
+ *
+ * @return     Statistics of the accepted samples
+ */
+RTTStatistics compute_rtt_statistics(std::vector<uint64_t> aSamples, uint64_t aMaxSpread);
+
+/**
+ * @brief      Increase of a 32 bit firmware counter between two readings.
+ *
+ *             A drop is taken as a wraparound only if the wrapped increase could
+ *             have happened in aElapsed at one command per clock tick, which
+ *             needs the previous value to be close to 2^32. Any other drop is a
+ *             counter reset, and the increase is the new value.
+ *
+ * @param[in]  aPrevious  Previous reading
+ * @param[in]  aCurrent   Current reading
+ * @param[in]  aElapsed   Time between the readings
+ *
+ * @return     Number of counts since the previous reading
+ */
+uint64_t counter_increase(uint64_t aPrevious, uint64_t aCurrent, std::chrono::duration<double> aElapsed);
+
 BoardType convert_value_to_board_type(uint32_t aBoardType);
 CarrierType convert_value_to_carrier_type(uint32_t aCarrierType);
 DesignType convert_value_to_design_type(uint32_t aDesignType);
@@ -8,6 +8,7 @@ from timing.common.definitions import kLibrarySupportedBoards
 
 from click import echo, style, secho
 from .click_texttable import Texttable
+from timing.core import BulkReader
 import time
 
 
@@ -117,33 +118,20 @@ def status(obj, watch, period):
     '''
     Display the endpoint status, accepted and rejected command counters
     '''
-    lNumCtrs = 0x10
-
-    lDevice = obj.mDevice
     lEndpoints = obj.mEndpoints
-    lEndPointNode = lDevice.getNode('endpoint0')
+    lEPKeys = sorted(lEndpoints)
+
+    # All endpoints are read in a single dispatch
+    lReader = BulkReader()
+    for p in lEPKeys:
+        lReader.add_endpoint(str(p), lEndpoints[p])
 
     while(True):
         if watch:
             click.clear()
-        
-        lEPKeys = sorted(lEndpoints)
-        lEPData = { p:{} for p,_ in lEndpoints.items() }
-
-        for p,n in lEndpoints.items():
-
-            lData = lEPData[p]
-            lData['tstamp'] = n.getNode('tstamp').readBlock(2)
-            lData['evtctr'] = n.getNode('evtctr').read()
-            lData['bufcount'] = n.getNode('buf.count').read()
-
-            lData['ctrldump'] = toolbox.readSubNodes(n.getNode('csr.ctrl'), False)
-            lData['statdump'] = toolbox.readSubNodes(n.getNode('csr.stat'), False)
-            lData['ctrs'] = n.getNode('ctrs').readBlock(lNumCtrs)
-        lDevice.dispatch()
-
 
-        lTimeStamp = lEndPointNode.read_timestamp()
+        lSnapshot = lReader.read()
+        lEPData = { p:lSnapshot.endpoints[str(p)] for p in lEPKeys }
 
         lEPSummary = Texttable(max_width=0)
         lEPSummary.set_deco(Texttable.VLINES | Texttable.BORDER | Texttable.HEADER )
@@ -152,36 +140,36 @@ def status(obj, watch, period):
         lEPSummary.set_cols_dtype(['t']*(len(lEPKeys)+1))
         lEPSummary.add_row(
                 ['State']+
-                [defs.fmtEpState(lEPData[p]['statdump']['ep_stat']) for p in lEPKeys
+                [defs.fmtEpState(lEPData[p].state) for p in lEPKeys
                 ]
         )
         lEPSummary.add_row(
                 ['Partition']+
-                [str(lEPData[p]['ctrldump']['tgrp']) for p in lEPKeys]
+                [str(lEPData[p].partition) for p in lEPKeys]
         )
         lEPSummary.add_row(
                 ['Address']+
-                [str(lEPData[p]['ctrldump']['addr']) for p in lEPKeys]
+                [str(lEPData[p].address) for p in lEPKeys]
         )
         lEPSummary.add_row(
                 ['Timestamp']+
-                [style(str(toolbox.formatTStamp(lEPData[p]['tstamp'])), fg='blue') for p in lEPKeys]
+                [style(str(toolbox.formatTStampInt(lEPData[p].timestamp)), fg='blue') for p in lEPKeys]
         )
         lEPSummary.add_row(
                 ['Timestamp (hex)']+
-                [hex(toolbox.tstamp2int(lEPData[p]['tstamp'])) for p in lEPKeys]
+                [hex(lEPData[p].timestamp) for p in lEPKeys]
         )        
         lEPSummary.add_row(
                 ['EventCounter']+
-                [str(lEPData[p]['evtctr']) for p in lEPKeys]
+                [str(lEPData[p].event_counter) for p in lEPKeys]
         )
         lEPSummary.add_row(
                 ['Buffer status']+
-                [style('OK', fg='green') if (lEPData[p]['statdump']['buf_err'] == 0x0) else style('Error', fg='red') for p in lEPKeys]
+                [style('OK', fg='green') if not lEPData[p].buffer_error else style('Error', fg='red') for p in lEPKeys]
         )
         lEPSummary.add_row(
                 ['Buffer occupancy']+
-                [str(lEPData[p]['bufcount']) for p in lEPKeys]
+                [str(lEPData[p].buffer_count) for p in lEPKeys]
         )
         echo ( lEPSummary.draw() )
 
@@ -196,12 +184,12 @@ def status(obj, watch, period):
 
         lEPStats.header( ['Endpoint']+lEPKeys )
 
-        for k in sorted(lEPData[lEPKeys[0]]['statdump']):
+        for k in sorted(lEPData[lEPKeys[0]].status):
             lEPStats.add_row(
                 [k]+
                 [
                     style(hex(v), fg=('blue' if v != 0 else 'white')) 
-                    for v in ( lEPData[p]['statdump'][k]  for p in lEPKeys ) 
+                    for v in ( lEPData[p].status[k]  for p in lEPKeys ) 
                 ]
             )
         echo ( lEPStats.draw() )
@@ -216,10 +204,10 @@ def status(obj, watch, period):
         lEPCtrs.set_cols_width([12]+[8]*(len(lEPKeys)))
 
         lEPCtrs.header( ['Endpoint']+lEPKeys )
-        for c in range(lNumCtrs):
+        for c in range(len(lEPData[lEPKeys[0]].counters)):
             lEPCtrs.add_row(
                 [defs.kCommandNames.get(c)]+
-                [k if k > 0 else '' for k in (lEPData[p]['ctrs'][c] for p in lEPKeys)]
+                [k if k > 0 else '' for k in (lEPData[p].counters[c] for p in lEPKeys)]
                 )
         echo ( lEPCtrs.draw() )
 
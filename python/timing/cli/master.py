@@ -17,7 +17,7 @@ import timing.common.definitions as defs
 
 from click import echo, style, secho
 from os.path import join, expandvars, basename
-from timing.core import SI534xSlave, I2CExpanderSlave
+from timing.core import SI534xSlave, I2CExpanderSlave, PartitionBufferPoller, event_record_dtype
 
 kMasterFWMajorRequired = 5
 
@@ -104,10 +104,12 @@ def synctime(obj):
 # ------------------------------------------------------------------------------
 @master.command('synctime', short_help="Sync timestamps with computer local time.")
 @click.pass_obj
-def synctime(obj):
+@click.option('--samples', '-s', type=click.IntRange(1, 1000), default=16, help='Timestamp reads used to estimate the IPbus latency')
+def synctime(obj, samples):
 
     lMasterTop = obj.mMasterTop
-    lMasterTop.sync_timestamp()
+    lOffset = lMasterTop.sync_timestamp(samples)
+    echo("Offset from host clock: {} +/- {} ticks".format(lOffset.offset, lOffset.uncertainty))
 # ------------------------------------------------------------------------------
 
 
@@ -222,8 +224,8 @@ def start(obj):
     - enables the readout buffer
     - enables triggers
     '''
-    obj.mPartitionNode.start()
-    secho("Partition {} started".format(obj.mPartitionId), fg='green')
+    lLatency = obj.mPartitionNode.start()
+    secho("Partition {} started ({:.3f} ms)".format(obj.mPartitionId, lLatency.total_seconds()*1e3), fg='green')
 # ------------------------------------------------------------------------------
 
 
@@ -254,8 +256,8 @@ def stop(obj):
     '''
 
     # Select the desired partition
-    obj.mPartitionNode.stop()
-    secho("Partition {} stopped".format(obj.mPartitionId), fg='green')
+    lLatency = obj.mPartitionNode.stop()
+    secho("Partition {} stopped ({:.3f} ms)".format(obj.mPartitionId, lLatency.total_seconds()*1e3), fg='green')
 # ------------------------------------------------------------------------------
 
 
@@ -275,32 +277,35 @@ def readback(obj, readall, keep):
     '''
     Read the content of the timing master readout buffer.
     '''
-    def chunks(l, n):
-        """Yield successive n-sized chunks from l."""
-        for i in range(0, len(l), n):
-            yield l[i:i + n]
 
     # lPartId = obj.mPartitionId
     lPartNode = obj.mPartitionNode
 
-    while(True):
-        lBufCount = lPartNode.read_buffer_word_count()
-
-        echo ( "Words available in readout buffer: "+hex(lBufCount))
+    # Continuous event readout paces itself on the buffer occupancy
+    lPoller = PartitionBufferPoller(lPartNode) if (keep and not readall) else None
 
-        lWordsToRead = int(lBufCount) if readall else (int(lBufCount) / defs.kEventSize)*defs.kEventSize
+    while(True):
+        if lPoller is not None:
+            lBufData = lPoller.wait_and_poll()
+            if not len(lBufData):
+                continue
+            echo ( "Words read from readout buffer: "+hex(len(lBufData)))
+        else:
+            lBufCount = lPartNode.read_buffer_word_count()
 
-        # if lWordsToRead == 0:
-            # echo("Nothing to read, goodbye!")
+            echo ( "Words available in readout buffer: "+hex(lBufCount))
 
-        lBufData = lPartNode.getNode('buf.data').readBlock(lWordsToRead)
-        lPartNode.getClient().dispatch()
+            lWordsToRead = int(lBufCount) if readall else (int(lBufCount) // defs.kEventSize)*defs.kEventSize
 
+            # if lWordsToRead == 0:
+                # echo("Nothing to read, goodbye!")
 
+            lBufData = lPartNode.read_buffer_data(lWordsToRead)
 
-        for i,c in enumerate(chunks(lBufData, 6)):
-            ts = (c[3]<<32) +c[2]
-            # print ('header:', hex(c[0]), hex(c[1]))
+        # View complete events as records, without copying the words
+        lEvents = lBufData[:len(lBufData) - len(lBufData) % defs.kEventSize].view(event_record_dtype)
+        for i, ts in enumerate(lEvents['timestamp']):
+            ts = int(ts)
             print ('ev {} - ts    : {} ({})'.format(i, ts, hex(ts)))
 
 
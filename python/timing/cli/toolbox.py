@@ -303,8 +303,12 @@ def escape_ansi(line):
 
 # ------------------------------------------------------------------------------
 def formatTStamp( aRawTStamp ):
-    ts = int(aRawTStamp[0]) + int((aRawTStamp[1]) << 32)
-    
+    return formatTStampInt(tstamp2int(aRawTStamp))
+# ------------------------------------------------------------------------------
+
+
+# ------------------------------------------------------------------------------
+def formatTStampInt( ts ):
     lSubSec = ts % defs.kSPSClockInHz
     lSecFromEpoch = ts / defs.kSPSClockInHz
 
@@ -1 +1,2 @@
-from ._core import *
\ No newline at end of file
+from ._core import *
+from .operations import Operation, submit, shutdown
@@ -0,0 +1,159 @@
+"""
+Future-returning and awaitable variants of the long timing operations.
+
+The blocking bindings in _core release the GIL, so they can run on worker
+threads while the interpreter carries on. Each long method <name> gets a
+<name>_async variant that returns an Operation: a concurrent.futures.Future
+that can also be awaited from asyncio code.
+
+    ops = [io.reset_async(clock_config_file=cfg) for io in io_nodes]
+    for op in ops: op.result()
+
+    await asyncio.gather(*(io.reset_async() for io in io_nodes))
+
+uHAL clients are not thread safe: operations on nodes of the same board,
+including the I2C slaves reached through the board's I2C masters, are
+queued and run one at a time, in submission order, on a single worker;
+operations on different boards run concurrently, up to kMaxWorkers boards
+at a time. Only operations submitted through this module are serialised.
+"""
+
+import asyncio
+import collections
+import threading
+
+from concurrent.futures import Future, ThreadPoolExecutor
+
+from . import _core
+
+
+# ------------------------------------------------------------------------------
+class Operation(Future):
+    """Future of a timing operation, awaitable from a running event loop"""
+
+    def __await__(self):
+        return asyncio.wrap_future(self).__await__()
+
+
+# ------------------------------------------------------------------------------
+kMaxWorkers = 16
+
+_executor = None
+_executor_lock = threading.Lock()
+
+_board_queues = {}
+_board_queues_lock = threading.Lock()
+
+
+def _get_executor():
+    global _executor
+    with _executor_lock:
+        if _executor is None:
+            _executor = ThreadPoolExecutor(max_workers=kMaxWorkers, thread_name_prefix='timing-op')
+        return _executor
+
+
+class _BoardQueue(object):
+    """Operations of one board, run in submission order by at most one worker"""
+
+    def __init__(self):
+        self._pending = collections.deque()
+        self._lock = threading.Lock()
+        self._draining = False
+
+    def push(self, task):
+        with self._lock:
+            self._pending.append(task)
+            if self._draining:
+                return
+            self._draining = True
+        _get_executor().submit(self._drain)
+
+    def _drain(self):
+        while True:
+            with self._lock:
+                if not self._pending:
+                    self._draining = False
+                    return
+                lTask = self._pending.popleft()
+            lTask()
+
+
+def _get_board_queue(node):
+    # I2C slaves are not uHAL nodes: they use the client of the I2C master they sit behind
+    if not hasattr(node, 'getClient') and hasattr(node, 'get_master'):
+        node = node.get_master()
+    try:
+        lKey = node.getClient().id()
+    except AttributeError:
+        raise TypeError('Cannot tell the board of {}: not a uHAL node nor an I2C slave'.format(type(node).__name__))
+    with _board_queues_lock:
+        return _board_queues.setdefault(lKey, _BoardQueue())
+
+
+def submit(node, method, *args, **kwargs):
+    """
+    Run method(node, *args, **kwargs) on a worker thread.
+
+    Returns an Operation holding the result, or the exception raised.
+    """
+    lOperation = Operation()
+    lBoardQueue = _get_board_queue(node)
+
+    def run():
+        if not lOperation.set_running_or_notify_cancel():
+            return
+        try:
+            lResult = method(node, *args, **kwargs)
+        except BaseException as e:
+            lOperation.set_exception(e)
+        else:
+            lOperation.set_result(lResult)
+
+    lBoardQueue.push(run)
+    return lOperation
+
+
+def shutdown(wait=True):
+    """Stop the worker threads, e.g. before exiting the interpreter"""
+    global _executor
+    with _executor_lock:
+        if _executor is not None:
+            _executor.shutdown(wait=wait)
+            _executor = None
+
+
+# ------------------------------------------------------------------------------
+# Long operations, per class. Their bindings release the GIL.
+kLongOperations = {
+    'I2CMasterNode': ['scan', 'reset'],
+    'SI534xSlave': ['configure'],
+    'FMCIONode': ['reset', 'soft_reset', 'get_clock_frequencies_table', 'get_pll_status'],
+    'PC059IONode': ['reset', 'soft_reset', 'get_clock_frequencies_table', 'get_pll_status'],
+    'TLUIONode': ['reset', 'soft_reset', 'get_clock_frequencies_table', 'get_pll_status'],
+    'SIMIONode': ['reset', 'soft_reset', 'get_clock_frequencies_table', 'get_pll_status'],
+    'PDIMasterNode': ['apply_endpoint_delay', 'measure_endpoint_rtt', 'measure_endpoint_rtt_statistics',
+                      'enable_upstream_endpoint', 'sync_timestamp', 'start_partitions', 'stop_partitions'],
+    'PDIMasterDesign<TLUIONode>': ['apply_endpoint_delay', 'measure_endpoint_rtt'],
+    'PDIMasterDesign<FMCIONode>': ['apply_endpoint_delay', 'measure_endpoint_rtt'],
+    'FanoutDesign<PC059IONode,PDIMasterNode>': ['apply_endpoint_delay', 'measure_endpoint_rtt', 'scan_sfp_mux'],
+    'MasterMuxDesign<PC059IONode,PDIMasterNode>': ['apply_endpoint_delay', 'measure_endpoint_rtt', 'scan_sfp_mux'],
+}
+
+
+def _make_async(method):
+    def method_async(self, *args, **kwargs):
+        return submit(self, method, *args, **kwargs)
+    method_async.__name__ = method.__name__ + '_async'
+    method_async.__doc__ = 'Run {} on a worker thread; returns an Operation.'.format(method.__name__)
+    return method_async
+
+
+def _add_async_variants():
+    for lClassName, lMethods in kLongOperations.items():
+        lClass = getattr(_core, lClassName)
+        for lMethod in lMethods:
+            setattr(lClass, lMethod + '_async', _make_async(getattr(lClass, lMethod)))
+
+
+_add_async_variants()
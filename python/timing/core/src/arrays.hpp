@@ -0,0 +1,63 @@
+/**
+ * @file arrays.hpp
+ *
+ * NumPy views of buffers read out from the hardware. The arrays own the
+ * C++ buffers they view, through a capsule; nothing is copied.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_PYTHON_TIMING_CORE_SRC_ARRAYS_HPP_
+#define TIMING_PYTHON_TIMING_CORE_SRC_ARRAYS_HPP_
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "timing/PartitionNode.hpp"
+
+#include "uhal/ValMem.hpp"
+
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+namespace python {
+
+namespace py = pybind11;
+
+/**
+ * @brief      Array sharing the memory of a uHAL block read.
+ */
+template<typename T>
+py::array_t<T>
+as_array(const uhal::ValVector<T>& values) {
+    if (!values.size()) return py::array_t<T>(0);
+
+    auto* lValues = new uhal::ValVector<T>(values);
+    py::capsule lOwner(lValues, [](void* p) { delete static_cast<uhal::ValVector<T>*>(p); });
+    return py::array_t<T>(lValues->size(), &*lValues->begin(), lOwner);
+}
+
+/**
+ * @brief      Array of event records sharing the memory of a uHAL block read; a trailing partial event is left out.
+ *
+ *             The record dtype is registered by register_partition.
+ */
+inline py::array_t<PartitionEventRecord>
+as_event_records(const uhal::ValVector<uint32_t>& words) {
+    if (words.size() < PartitionNode::kWordsPerEvent) return py::array_t<PartitionEventRecord>(0);
+
+    auto* lWords = new uhal::ValVector<uint32_t>(words);
+    py::capsule lOwner(lWords, [](void* p) { delete static_cast<uhal::ValVector<uint32_t>*>(p); });
+    return py::array_t<PartitionEventRecord>(lWords->size() / PartitionNode::kWordsPerEvent,
+                                             reinterpret_cast<const PartitionEventRecord*>(&*lWords->begin()),
+                                             lOwner);
+}
+
+} // namespace python
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_PYTHON_TIMING_CORE_SRC_ARRAYS_HPP_
@@ -13,6 +13,7 @@ namespace python {
 	extern void register_io(py::module &);
 	extern void register_master(py::module &);
 	extern void register_top_designs(py::module &);
+	extern void register_monitoring(py::module &);
 
 PYBIND11_MODULE(_core, m) {
 
@@ -24,6 +25,7 @@ PYBIND11_MODULE(_core, m) {
 	timing::python::register_io(m);
 	timing::python::register_master(m);
 	timing::python::register_top_designs(m);
+	timing::python::register_monitoring(m);
 
 }
 
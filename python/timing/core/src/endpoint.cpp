@@ -4,6 +4,8 @@
 #include "timing/EndpointNode.hpp"
 #include "timing/CRTNode.hpp"
 
+#include "arrays.hpp"
+
 namespace py = pybind11;
 
 namespace dunedaq {
@@ -18,11 +20,13 @@ register_endpoint(py::module& m) {
       .def("enable", &timing::EndpointNode::enable, py::arg("partition") = 0, py::arg("address") = 0)
       .def("reset", &timing::EndpointNode::reset, py::arg("partition") = 0, py::arg("address") = 0)
       .def("read_buffer_count", &timing::EndpointNode::read_buffer_count)
-      .def("read_data_buffer", &timing::EndpointNode::read_data_buffer, py::arg("read_all") = false)
+      .def("read_data_buffer", [](const timing::EndpointNode& e, bool read_all) { return as_array(e.read_data_buffer(read_all)); }, py::arg("read_all") = false)
       .def("get_data_buffer_table", &timing::EndpointNode::get_data_buffer_table, py::arg("read_all") = false, py::arg("print_out") = false)
       .def("read_version", &timing::EndpointNode::read_version)
+      .def("read_command_counters", &timing::EndpointNode::read_command_counters)
       .def("read_timestamp", &timing::EndpointNode::read_timestamp)
       .def("read_clock_frequency", &timing::EndpointNode::read_clock_frequency)
+      .def("report_status", &timing::EndpointNode::report_status, py::arg("sink"))
       ;
 
   py::class_<timing::CRTNode, uhal::Node> (m, "CRTNode")
@@ -30,6 +34,7 @@ register_endpoint(py::module& m) {
       .def("disable", &timing::CRTNode::disable)
       .def("enable", &timing::CRTNode::enable)
       .def("get_status", &timing::CRTNode::get_status, py::arg("print_out") = false)
+      .def("report_status", &timing::CRTNode::report_status, py::arg("sink"))
       .def("read_last_pulse_timestamp", &timing::CRTNode::read_last_pulse_timestamp)
       ;
 }
@@ -34,8 +34,8 @@ register_i2c(py::module& m) {
     .def("get_slave", &timing::I2CMasterNode::get_slave, py::return_value_policy::reference_internal)
     .def("get_slave_address", &timing::I2CMasterNode::get_slave_address)
     .def("ping", &timing::I2CMasterNode::ping)
-    .def("scan", &timing::I2CMasterNode::scan)
-    .def("reset", &timing::I2CMasterNode::reset)
+    .def("scan", &timing::I2CMasterNode::scan, py::call_guard<py::gil_scoped_release>())
+    .def("reset", &timing::I2CMasterNode::reset, py::call_guard<py::gil_scoped_release>())
     ;
 
   // Wrap timing::I2CSlave    
@@ -52,6 +52,7 @@ register_i2c(py::module& m) {
     .def("read_i2cPrimitive", &timing::I2CSlave::read_i2cPrimitive)
     .def("write_i2cPrimitive", &timing::I2CSlave::write_i2cPrimitive, py::arg("data"), py::arg("send_stop") = true)
     .def("ping", &timing::I2CSlave::ping)
+    .def("get_master", &timing::I2CSlave::get_master, py::return_value_policy::reference_internal)
     ;
 
   // Wrap SIChipSlave
@@ -67,8 +68,9 @@ register_i2c(py::module& m) {
   // Wrap SI534xSlave
   py::class_<timing::SI534xSlave, timing::SIChipSlave> (m, "SI534xSlave")
     .def(py::init<const timing::I2CMasterNode*, uint8_t>())
-    .def("configure", &timing::SI534xSlave::configure)
+    .def("configure", &timing::SI534xSlave::configure, py::call_guard<py::gil_scoped_release>())
     .def("read_config_id", &timing::SI534xSlave::read_config_id)
+    .def("report_status", &timing::SI534xSlave::report_status, py::arg("sink"))
     // .def("registers", &timing::SI534xSlave::registers)
     ;
 
@@ -1,5 +1,6 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/chrono.h>
 
 #include "timing/IONode.hpp"
 #include "timing/FMCIONode.hpp"
@@ -17,15 +18,20 @@ void
 register_io(py::module& m) {
       
       py::class_<timing::IONode, uhal::Node> (m, "IONode")
+        .def_static("read_clock_frequencies",
+                    py::overload_cast<const std::vector<const IONode*>&, std::chrono::milliseconds>(&timing::IONode::read_clock_frequencies),
+                    py::arg("io_nodes"),
+                    py::arg("timeout") = std::chrono::milliseconds(2000), py::call_guard<py::gil_scoped_release>())
       ;
       
       py::class_<timing::FMCIONode, timing::IONode, uhal::Node> (m, "FMCIONode")
         .def(py::init<const uhal::Node&>())
-        .def("reset", &timing::FMCIONode::reset, py::arg("clock_config_file") = "")
-        .def("soft_reset", &timing::FMCIONode::soft_reset)
-        .def("get_clock_frequencies_table", &timing::FMCIONode::get_clock_frequencies_table, py::arg("print_out") = false)
+        .def("reset", &timing::FMCIONode::reset, py::arg("clock_config_file") = "", py::call_guard<py::gil_scoped_release>())
+        .def("soft_reset", &timing::FMCIONode::soft_reset, py::call_guard<py::gil_scoped_release>())
+        .def("get_clock_frequencies_table", &timing::FMCIONode::get_clock_frequencies_table, py::arg("print_out") = false, py::call_guard<py::gil_scoped_release>())
         .def("get_status", &timing::FMCIONode::get_status, py::arg("print_out") = false)
-        .def("get_pll_status", &timing::FMCIONode::get_pll_status, py::arg("print_out") = false)
+        .def("report_status", &timing::FMCIONode::report_status, py::arg("sink"))
+        .def("get_pll_status", &timing::FMCIONode::get_pll_status, py::arg("print_out") = false, py::call_guard<py::gil_scoped_release>())
         .def("get_hardware_info", &timing::FMCIONode::get_hardware_info, py::arg("print_out") = false)
         .def("get_sfp_status", &timing::FMCIONode::get_sfp_status, py::arg("sfp_id"), py::arg("print_out") = false)
         .def("switch_sfp_soft_tx_control_bit", &timing::FMCIONode::switch_sfp_soft_tx_control_bit)
@@ -33,26 +39,30 @@ register_io(py::module& m) {
 
       py::class_<timing::PC059IONode, timing::IONode, uhal::Node> (m, "PC059IONode")
         .def(py::init<const uhal::Node&>())
-        .def<void (timing::PC059IONode::*)(const std::string&) const>("reset", &timing::PC059IONode::reset, py::arg("clock_config_file") = "")
-        .def<void (timing::PC059IONode::*)(int32_t,const std::string&) const>("reset", &timing::PC059IONode::reset, py::arg("fanout_mode"), py::arg("clock_config_file") = "")
-        .def("soft_reset", &timing::PC059IONode::soft_reset)
-        .def("get_clock_frequencies_table", &timing::PC059IONode::get_clock_frequencies_table, py::arg("print_out") = false)
+        .def<void (timing::PC059IONode::*)(const std::string&) const>("reset", &timing::PC059IONode::reset, py::arg("clock_config_file") = "", py::call_guard<py::gil_scoped_release>())
+        .def<void (timing::PC059IONode::*)(int32_t,const std::string&) const>("reset", &timing::PC059IONode::reset, py::arg("fanout_mode"), py::arg("clock_config_file") = "", py::call_guard<py::gil_scoped_release>())
+        .def("soft_reset", &timing::PC059IONode::soft_reset, py::call_guard<py::gil_scoped_release>())
+        .def("get_clock_frequencies_table", &timing::PC059IONode::get_clock_frequencies_table, py::arg("print_out") = false, py::call_guard<py::gil_scoped_release>())
         .def("get_status", &timing::PC059IONode::get_status, py::arg("print_out") = false)
-        .def("get_pll_status", &timing::PC059IONode::get_pll_status, py::arg("print_out") = false)
+        .def("report_status", &timing::PC059IONode::report_status, py::arg("sink"))
+        .def("get_pll_status", &timing::PC059IONode::get_pll_status, py::arg("print_out") = false, py::call_guard<py::gil_scoped_release>())
         .def("get_hardware_info", &timing::PC059IONode::get_hardware_info, py::arg("print_out") = false)
         .def("get_sfp_status", &timing::PC059IONode::get_sfp_status, py::arg("sfp_id"), py::arg("print_out") = false)
         .def("switch_sfp_soft_tx_control_bit", &timing::PC059IONode::switch_sfp_soft_tx_control_bit)
         .def("switch_sfp_mux_channel", &timing::PC059IONode::switch_sfp_mux_channel)
         .def("read_active_sfp_mux_channel", &timing::PC059IONode::read_active_sfp_mux_channel)
+        .def("get_number_of_sfp_mux_channels", &timing::PC059IONode::get_number_of_sfp_mux_channels)
+        .def("read_sfp_los_flags", &timing::PC059IONode::read_sfp_los_flags)
       ;
 
       py::class_<timing::TLUIONode, timing::IONode, uhal::Node> (m, "TLUIONode")
         .def(py::init<const uhal::Node&>())
-        .def("reset", &timing::TLUIONode::reset, py::arg("clock_config_file") = "")
-        .def("soft_reset", &timing::TLUIONode::soft_reset)
-        .def("get_clock_frequencies_table", &timing::TLUIONode::get_clock_frequencies_table, py::arg("print_out") = false)
+        .def("reset", &timing::TLUIONode::reset, py::arg("clock_config_file") = "", py::call_guard<py::gil_scoped_release>())
+        .def("soft_reset", &timing::TLUIONode::soft_reset, py::call_guard<py::gil_scoped_release>())
+        .def("get_clock_frequencies_table", &timing::TLUIONode::get_clock_frequencies_table, py::arg("print_out") = false, py::call_guard<py::gil_scoped_release>())
         .def("get_status", &timing::TLUIONode::get_status, py::arg("print_out") = false)
-        .def("get_pll_status", &timing::TLUIONode::get_pll_status, py::arg("print_out") = false)
+        .def("report_status", &timing::TLUIONode::report_status, py::arg("sink"))
+        .def("get_pll_status", &timing::TLUIONode::get_pll_status, py::arg("print_out") = false, py::call_guard<py::gil_scoped_release>())
         .def("get_hardware_info", &timing::TLUIONode::get_hardware_info, py::arg("print_out") = false)
         .def("get_sfp_status", &timing::TLUIONode::get_sfp_status, py::arg("sfp_id"), py::arg("print_out") = false)
         .def("switch_sfp_soft_tx_control_bit", &timing::TLUIONode::switch_sfp_soft_tx_control_bit)
@@ -61,11 +71,12 @@ register_io(py::module& m) {
   
       py::class_<timing::SIMIONode, timing::IONode, uhal::Node> (m, "SIMIONode")
         .def(py::init<const uhal::Node&>())
-        .def("reset", &timing::SIMIONode::reset, py::arg("clock_config_file") = "")
-        .def("soft_reset", &timing::SIMIONode::soft_reset)
-        .def("get_clock_frequencies_table", &timing::SIMIONode::get_clock_frequencies_table, py::arg("print_out") = false)
+        .def("reset", &timing::SIMIONode::reset, py::arg("clock_config_file") = "", py::call_guard<py::gil_scoped_release>())
+        .def("soft_reset", &timing::SIMIONode::soft_reset, py::call_guard<py::gil_scoped_release>())
+        .def("get_clock_frequencies_table", &timing::SIMIONode::get_clock_frequencies_table, py::arg("print_out") = false, py::call_guard<py::gil_scoped_release>())
         .def("get_status", &timing::SIMIONode::get_status, py::arg("print_out") = false)
-        .def("get_pll_status", &timing::SIMIONode::get_pll_status, py::arg("print_out") = false)
+        .def("report_status", &timing::SIMIONode::report_status, py::arg("sink"))
+        .def("get_pll_status", &timing::SIMIONode::get_pll_status, py::arg("print_out") = false, py::call_guard<py::gil_scoped_release>())
         .def("get_hardware_info", &timing::SIMIONode::get_hardware_info, py::arg("print_out") = false)
         .def("get_sfp_status", &timing::SIMIONode::get_sfp_status, py::arg("sfp_id"), py::arg("print_out") = false)
         .def("switch_sfp_soft_tx_control_bit", &timing::SIMIONode::switch_sfp_soft_tx_control_bit)
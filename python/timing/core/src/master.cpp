@@ -1,7 +1,11 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/chrono.h>
 
 #include "timing/PDIMasterNode.hpp"
+#include "timing/EndpointNode.hpp"
+#include "timing/FLCmdGeneratorNode.hpp"
+#include "timing/TimestampCorrelator.hpp"
 
 namespace py = pybind11;
 
@@ -14,17 +18,63 @@ register_master(py::module& m) {
       py::class_<timing::PDIMasterNode, uhal::Node> (m, "PDIMasterNode")
       .def(py::init<const uhal::Node&>())
       .def<void (timing::PDIMasterNode::*)(uint32_t,uint32_t,uint32_t,uint32_t,bool,bool) const>("apply_endpoint_delay", &timing::PDIMasterNode::apply_endpoint_delay, 
-            py::arg("address"), py::arg("coarse_delay"), py::arg("fine_delay"), py::arg("phase_delay"), py::arg("control_sfp") = true, py::arg("control_sfp") = true)
-      .def("measure_endpoint_rtt", &timing::PDIMasterNode::measure_endpoint_rtt, py::arg("address"), py::arg("control_sfp") = true)
+            py::arg("address"), py::arg("coarse_delay"), py::arg("fine_delay"), py::arg("phase_delay"), py::arg("measure_rtt") = false, py::arg("control_sfp") = true, py::call_guard<py::gil_scoped_release>())
+      .def("measure_endpoint_rtt", &timing::PDIMasterNode::measure_endpoint_rtt, py::arg("address"), py::arg("control_sfp") = true, py::call_guard<py::gil_scoped_release>())
+      .def("measure_endpoint_rtt_statistics", &timing::PDIMasterNode::measure_endpoint_rtt_statistics, py::arg("address"), py::arg("number_of_echoes"), py::arg("control_sfp") = true, py::call_guard<py::gil_scoped_release>())
       .def("switch_endpoint_sfp", &timing::PDIMasterNode::switch_endpoint_sfp)
-      .def("enable_upstream_endpoint", &timing::PDIMasterNode::enable_upstream_endpoint)
+      .def("enable_upstream_endpoint", &timing::PDIMasterNode::enable_upstream_endpoint, py::arg("timeout") = 500, py::call_guard<py::gil_scoped_release>())
       .def("send_fl_cmd", &timing::PDIMasterNode::send_fl_cmd, py::arg("command"), py::arg("channel"), py::arg("number_of_commands") = 1)
       .def("enable_fake_trigger", &timing::PDIMasterNode::enable_fake_trigger, py::arg("channel"), py::arg("rate"), py::arg("poisson") = false)
       .def("disable_fake_trigger", &timing::PDIMasterNode::disable_fake_trigger)
       .def("enable_spill_interface", &timing::PDIMasterNode::enable_spill_interface)
       .def("enable_fake_spills", &timing::PDIMasterNode::enable_fake_spills, py::arg("cycle_length") = 16, py::arg("spill_length") = 8)
       .def("get_status", &timing::PDIMasterNode::get_status, py::arg("print_out") = false)
-      .def("sync_timestamp", &timing::PDIMasterNode::sync_timestamp)
+      .def("report_status", &timing::PDIMasterNode::report_status, py::arg("sink"))
+      .def("sync_timestamp", &timing::PDIMasterNode::sync_timestamp, py::arg("samples") = 16, py::call_guard<py::gil_scoped_release>())
+      .def("get_partition_node", &timing::PDIMasterNode::get_partition_node, py::return_value_policy::reference_internal)
+      .def("configure_partitions", &timing::PDIMasterNode::configure_partitions, py::arg("partition_ids"), py::arg("trigger_mask"), py::arg("enable_spill_gate"), py::arg("rate_control_enabled") = true)
+      .def("start_partitions", &timing::PDIMasterNode::start_partitions, py::arg("partition_ids"), py::arg("timeout") = 5000, py::call_guard<py::gil_scoped_release>())
+      .def("stop_partitions", &timing::PDIMasterNode::stop_partitions, py::arg("partition_ids"), py::arg("timeout") = 5000, py::call_guard<py::gil_scoped_release>())
+      ;
+
+      py::class_<timing::RTTStatistics>(m, "RTTStatistics")
+      .def_readonly("samples", &timing::RTTStatistics::samples)
+      .def_readonly("accepted", &timing::RTTStatistics::accepted)
+      .def_readonly("min", &timing::RTTStatistics::min)
+      .def_readonly("median", &timing::RTTStatistics::median)
+      .def_readonly("max", &timing::RTTStatistics::max)
+      .def_readonly("stddev", &timing::RTTStatistics::stddev)
+      .def_readonly("unstable", &timing::RTTStatistics::unstable)
+      ;
+
+      py::class_<timing::TimestampOffset>(m, "TimestampOffset")
+      .def_readonly("samples", &timing::TimestampOffset::samples)
+      .def_readonly("offset", &timing::TimestampOffset::offset)
+      .def_readonly("uncertainty", &timing::TimestampOffset::uncertainty)
+      .def_readonly("round_trip", &timing::TimestampOffset::round_trip)
+      ;
+
+      py::class_<timing::TimestampEstimate>(m, "TimestampEstimate")
+      .def_readonly("timestamp", &timing::TimestampEstimate::timestamp)
+      .def_readonly("error", &timing::TimestampEstimate::error)
+      ;
+
+      py::class_<timing::TimestampCorrelator>(m, "TimestampCorrelator")
+      .def(py::init([](const timing::PDIMasterNode& master, std::chrono::nanoseconds max_error, uint32_t samples_per_update, uint32_t history) {
+             return new timing::TimestampCorrelator([&master]() { return master.read_timestamp(); }, max_error, samples_per_update, history);
+           }),
+           py::arg("master"), py::arg("max_error") = std::chrono::microseconds(10), py::arg("samples_per_update") = 8, py::arg("history") = 16,
+           py::keep_alive<1, 2>())
+      .def(py::init([](const timing::EndpointNode& endpoint, std::chrono::nanoseconds max_error, uint32_t samples_per_update, uint32_t history) {
+             return new timing::TimestampCorrelator([&endpoint]() { return endpoint.read_timestamp(); }, max_error, samples_per_update, history);
+           }),
+           py::arg("endpoint"), py::arg("max_error") = std::chrono::microseconds(10), py::arg("samples_per_update") = 8, py::arg("history") = 16,
+           py::keep_alive<1, 2>())
+      .def("now", &timing::TimestampCorrelator::now)
+      .def("estimate", &timing::TimestampCorrelator::estimate)
+      .def("update", &timing::TimestampCorrelator::update)
+      .def("get_drift", &timing::TimestampCorrelator::get_drift)
+      .def("get_number_of_updates", &timing::TimestampCorrelator::get_number_of_updates)
       ;
 
       py::class_<timing::TriggerReceiverNode, uhal::Node> (m, "TriggerReceiverNode")
@@ -35,6 +85,15 @@ register_master(py::module& m) {
       .def("enable_triggers", &timing::TriggerReceiverNode::enable_triggers)
       .def("disable_triggers", &timing::TriggerReceiverNode::disable_triggers)
       .def("get_status", &timing::TriggerReceiverNode::get_status, py::arg("print_out") = false)
+      .def("report_status", &timing::TriggerReceiverNode::report_status, py::arg("sink"))
+      ;
+
+      py::class_<timing::FLCmdGeneratorNode, uhal::Node> (m, "FLCmdGeneratorNode")
+      .def(py::init<const uhal::Node&>())
+      .def("enable_fake_trigger", &timing::FLCmdGeneratorNode::enable_fake_trigger, py::arg("channel"), py::arg("divisor"), py::arg("prescale"), py::arg("poisson"))
+      .def("disable_fake_trigger", &timing::FLCmdGeneratorNode::disable_fake_trigger, py::arg("channel"))
+      .def("get_cmd_counters_table", &timing::FLCmdGeneratorNode::get_cmd_counters_table, py::arg("print_out") = false)
+      .def("get_status", &timing::FLCmdGeneratorNode::get_status, py::arg("print_out") = false)
       ;
 }
 
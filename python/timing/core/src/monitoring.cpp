@@ -0,0 +1,149 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/chrono.h>
+
+#include "timing/SharedSnapshot.hpp"
+#include "timing/MonitoringHistory.hpp"
+#include "timing/CounterRateEngine.hpp"
+#include "timing/StatusSink.hpp"
+#include "timing/BulkReader.hpp"
+#include "timing/DispatchAccounting.hpp"
+
+namespace py = pybind11;
+
+namespace dunedaq {
+namespace timing {
+namespace python {
+
+void
+register_monitoring(py::module& m) {
+
+      py::class_<timing::SharedSnapshot>(m, "SharedSnapshot")
+      .def_readonly("name", &timing::SharedSnapshot::name)
+      .def_property_readonly("payload", [](const timing::SharedSnapshot& s) { return py::bytes(s.payload); })
+      .def_readonly("time_gathered", &timing::SharedSnapshot::time_gathered)
+      .def_readonly("time_published", &timing::SharedSnapshot::time_published)
+      .def_readonly("version", &timing::SharedSnapshot::version)
+      ;
+
+      py::class_<timing::SharedSnapshotReader>(m, "SharedSnapshotReader")
+      .def(py::init<const std::string&>(), py::arg("name") = "/pdtguardian")
+      .def("read", &timing::SharedSnapshotReader::read, py::arg("record"))
+      .def("read_all", &timing::SharedSnapshotReader::read_all)
+      .def("get_record_names", &timing::SharedSnapshotReader::get_record_names)
+      ;
+
+      py::class_<timing::HistorySample>(m, "HistorySample")
+      .def_readonly("time", &timing::HistorySample::time)
+      .def_readonly("value", &timing::HistorySample::value)
+      ;
+
+      py::class_<timing::MonitoringHistory>(m, "MonitoringHistory")
+      .def(py::init<uint32_t, uint32_t>(), py::arg("block_size") = 4096, py::arg("blocks_per_series") = 16)
+      .def("record", &timing::MonitoringHistory::record, py::arg("key"), py::arg("value"), py::arg("time"))
+      .def("record", [](timing::MonitoringHistory& h, const std::string& key, uint64_t value) { return h.record(key, value); }, py::arg("key"), py::arg("value"))
+      .def("record_counters", &timing::MonitoringHistory::record_counters, py::arg("prefix"), py::arg("values"), py::arg("time"))
+      .def("record_counters", [](timing::MonitoringHistory& h, const std::string& prefix, const std::vector<uint32_t>& values) { return h.record_counters(prefix, values); }, py::arg("prefix"), py::arg("values"))
+      .def("query", &timing::MonitoringHistory::query, py::arg("key"), py::arg("start"), py::arg("end"))
+      .def("value_at", &timing::MonitoringHistory::value_at, py::arg("key"), py::arg("time"))
+      .def("rate", &timing::MonitoringHistory::rate, py::arg("key"), py::arg("start"), py::arg("end"))
+      .def("get_keys", &timing::MonitoringHistory::get_keys)
+      .def("get_memory_usage", &timing::MonitoringHistory::get_memory_usage)
+      ;
+
+      py::class_<timing::timingfirmwareinfo::TimingCounterRates>(m, "TimingCounterRates")
+      .def_readonly("name", &timing::timingfirmwareinfo::TimingCounterRates::name)
+      .def_readonly("labels", &timing::timingfirmwareinfo::TimingCounterRates::labels)
+      .def_readonly("totals", &timing::timingfirmwareinfo::TimingCounterRates::totals)
+      .def_readonly("rates", &timing::timingfirmwareinfo::TimingCounterRates::rates)
+      .def_readonly("window", &timing::timingfirmwareinfo::TimingCounterRates::window)
+      ;
+
+      py::class_<timing::CounterRateEngine>(m, "CounterRateEngine")
+      .def(py::init<std::chrono::milliseconds>(), py::arg("window") = std::chrono::seconds(10))
+      .def("add_counters", &timing::CounterRateEngine::add_counters, py::arg("name"), py::arg("counters"), py::arg("labels") = std::vector<std::string>(), py::keep_alive<1, 3>())
+      .def("add_partition", &timing::CounterRateEngine::add_partition, py::arg("name"), py::arg("partition"), py::keep_alive<1, 3>())
+      .def("add_fl_cmd_generator", &timing::CounterRateEngine::add_fl_cmd_generator, py::arg("name"), py::arg("generator"), py::keep_alive<1, 3>())
+      .def("add_trigger_receiver", &timing::CounterRateEngine::add_trigger_receiver, py::arg("name"), py::arg("receiver"), py::keep_alive<1, 3>())
+      .def("add_endpoint", &timing::CounterRateEngine::add_endpoint, py::arg("name"), py::arg("endpoint"), py::keep_alive<1, 3>())
+      .def("sample", &timing::CounterRateEngine::sample, py::arg("history") = nullptr)
+      .def("get_rates", &timing::CounterRateEngine::get_rates, py::arg("name"))
+      .def("get_all_rates", [](const timing::CounterRateEngine& e) {
+             timing::timingfirmwareinfo::TimingCounterRatesVector lRates;
+             e.get_info(lRates);
+             return lRates;
+           })
+      .def("get_names", &timing::CounterRateEngine::get_names)
+      ;
+
+      py::class_<timing::StatusSink>(m, "StatusSink")
+      .def("begin_section", &timing::StatusSink::begin_section, py::arg("name"))
+      .def("end_section", &timing::StatusSink::end_section)
+      .def("add_register", &timing::StatusSink::add_register, py::arg("name"), py::arg("value"))
+      .def("add_flag", &timing::StatusSink::add_flag, py::arg("name"), py::arg("value"))
+      .def("add_number", &timing::StatusSink::add_number, py::arg("name"), py::arg("value"), py::arg("unit") = "")
+      .def("add_text", &timing::StatusSink::add_text, py::arg("name"), py::arg("value"))
+      .def("add_counters", &timing::StatusSink::add_counters, py::arg("name"), py::arg("labels"), py::arg("values"))
+      ;
+
+      py::class_<timing::TextStatusRenderer, timing::StatusSink>(m, "TextStatusRenderer")
+      .def(py::init<>())
+      .def("get_text", &timing::TextStatusRenderer::get_text)
+      ;
+
+      py::class_<timing::JsonStatusRenderer, timing::StatusSink>(m, "JsonStatusRenderer")
+      .def(py::init<>())
+      .def("get_json", &timing::JsonStatusRenderer::get_json)
+      ;
+
+      py::class_<timing::BinaryStatusRenderer, timing::StatusSink>(m, "BinaryStatusRenderer")
+      .def(py::init<>())
+      .def("get_buffer", [](const timing::BinaryStatusRenderer& r) { return py::bytes(r.get_buffer()); })
+      ;
+
+      py::class_<timing::EndpointSnapshot>(m, "EndpointSnapshot")
+      .def_readonly("state", &timing::EndpointSnapshot::state)
+      .def_readonly("partition", &timing::EndpointSnapshot::partition)
+      .def_readonly("address", &timing::EndpointSnapshot::address)
+      .def_readonly("timestamp", &timing::EndpointSnapshot::timestamp)
+      .def_readonly("event_counter", &timing::EndpointSnapshot::event_counter)
+      .def_readonly("buffer_count", &timing::EndpointSnapshot::buffer_count)
+      .def_readonly("buffer_error", &timing::EndpointSnapshot::buffer_error)
+      .def_readonly("controls", &timing::EndpointSnapshot::controls)
+      .def_readonly("status", &timing::EndpointSnapshot::status)
+      .def_readonly("counters", &timing::EndpointSnapshot::counters)
+      ;
+
+      py::class_<timing::BulkSnapshot>(m, "BulkSnapshot")
+      .def_readonly("registers", &timing::BulkSnapshot::registers)
+      .def_readonly("blocks", &timing::BulkSnapshot::blocks)
+      .def_readonly("endpoints", &timing::BulkSnapshot::endpoints)
+      .def_readonly("dispatches", &timing::BulkSnapshot::dispatches)
+      .def_readonly("time", &timing::BulkSnapshot::time)
+      ;
+
+      py::class_<timing::BulkReader>(m, "BulkReader")
+      .def(py::init<>())
+      .def("add_register", &timing::BulkReader::add_register, py::arg("name"), py::arg("node"), py::keep_alive<1, 3>())
+      .def("add_registers", &timing::BulkReader::add_registers, py::arg("name"), py::arg("node"), py::keep_alive<1, 3>())
+      .def("add_block", &timing::BulkReader::add_block, py::arg("name"), py::arg("node"), py::arg("size") = 0, py::keep_alive<1, 3>())
+      .def("add_endpoint", &timing::BulkReader::add_endpoint, py::arg("name"), py::arg("endpoint"), py::keep_alive<1, 3>())
+      .def("read", &timing::BulkReader::read, py::call_guard<py::gil_scoped_release>())
+      .def("get_word_count", &timing::BulkReader::get_word_count)
+      ;
+
+      py::class_<timing::DispatchStats>(m, "DispatchStats")
+      .def_readonly("calls", &timing::DispatchStats::calls)
+      .def_readonly("dispatches", &timing::DispatchStats::dispatches)
+      .def_readonly("max_dispatches", &timing::DispatchStats::max_dispatches)
+      .def_readonly("time", &timing::DispatchStats::time)
+      ;
+
+      m.def("get_dispatch_stats", py::overload_cast<>(&timing::get_dispatch_stats));
+      m.def("get_dispatch_stats", py::overload_cast<const std::string&>(&timing::get_dispatch_stats), py::arg("key"));
+      m.def("reset_dispatch_stats", &timing::reset_dispatch_stats);
+}
+
+} // namespace python
+} // namespace timing
+} // namespace dunedaq
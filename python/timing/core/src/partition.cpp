@@ -1,7 +1,11 @@
 #include <pybind11/stl.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/chrono.h>
 
 #include "timing/PartitionNode.hpp"
+#include "timing/PartitionBufferPoller.hpp"
+
+#include "arrays.hpp"
 
 // Namespace resolution
 namespace py = pybind11;
@@ -12,23 +16,66 @@ namespace python {
 
 void
 register_partition(py::module& m) {
+  PYBIND11_NUMPY_DTYPE(timing::PartitionEventRecord, header, command, timestamp, event_counter, checksum);
+  m.attr("event_record_dtype") = py::dtype::of<timing::PartitionEventRecord>();
+
   py::class_<timing::PartitionNode, uhal::Node> (m, "PartitionNode")
       .def(py::init<const uhal::Node&>())
       .def("read_trigger_mask", &timing::PartitionNode::read_trigger_mask)
       // .def("writeTriggerMask", &timing::PartitionNode::writeTriggerMask)
-      .def("configure", &timing::PartitionNode::configure, py::arg("trigger_mask"), py::arg("enableSpillGate"), py::arg("rate_control_enabled") = 1)
+      .def("configure", &timing::PartitionNode::configure, py::arg("trigger_mask"), py::arg("enableSpillGate"), py::arg("rate_control_enabled") = 1, py::arg("dispatch") = true)
       .def("enable_triggers", &timing::PartitionNode::enable_triggers, py::arg("enable") = true)
       .def("read_buffer_word_count", &timing::PartitionNode::read_buffer_word_count)
       .def("num_events_in_buffer", &timing::PartitionNode::num_events_in_buffer)
       .def("read_rob_warning_overflow", &timing::PartitionNode::read_rob_warning_overflow)
       .def("read_rob_error", &timing::PartitionNode::read_rob_error)
-      .def("read_events", &timing::PartitionNode::read_events, py::arg("number_of_events") = 0)
+      .def("read_events", [](const timing::PartitionNode& p, size_t number_of_events) { return as_array(p.read_events(number_of_events)); }, py::arg("number_of_events") = 0)
+      .def("read_event_records", [](const timing::PartitionNode& p, size_t number_of_events) { return as_event_records(p.read_events(number_of_events)); }, py::arg("number_of_events") = 0)
+      .def("read_buffer_data", [](const timing::PartitionNode& p, uint32_t number_of_words) { return as_array(p.read_buffer_data(number_of_words)); }, py::arg("number_of_words"))
+      .def("read_buffer_status", &timing::PartitionNode::read_buffer_status)
+      .def("get_buffer_capacity", &timing::PartitionNode::get_buffer_capacity)
+      .def("get_buffer_read_size", &timing::PartitionNode::get_buffer_read_size)
       .def("enable", &timing::PartitionNode::enable, py::arg("enable")=true,  py::arg("dispatch")=true)
       .def("reset", &timing::PartitionNode::reset)
       .def("start", &timing::PartitionNode::start, py::arg("timeout") = 5000)
       .def("stop", &timing::PartitionNode::stop, py::arg("timeout") = 5000)
+      .def("request_run_state", &timing::PartitionNode::request_run_state, py::arg("in_run"), py::arg("dispatch") = true)
       .def("configure_rate_ctrl", &timing::PartitionNode::configure_rate_ctrl)
       .def("get_status", &timing::PartitionNode::get_status, py::arg("print_out")=false)
+      .def("report_status", &timing::PartitionNode::report_status, py::arg("sink"))
+      ;
+
+  py::class_<timing::PartitionBufferStatus>(m, "PartitionBufferStatus")
+      .def_readonly("word_count", &timing::PartitionBufferStatus::word_count)
+      .def_readonly("warning", &timing::PartitionBufferStatus::warning)
+      .def_readonly("error", &timing::PartitionBufferStatus::error)
+      ;
+
+  py::class_<timing::PartitionBufferPollerStats>(m, "PartitionBufferPollerStats")
+      .def_readonly("polls", &timing::PartitionBufferPollerStats::polls)
+      .def_readonly("events_read", &timing::PartitionBufferPollerStats::events_read)
+      .def_readonly("peak_word_count", &timing::PartitionBufferPollerStats::peak_word_count)
+      .def_readonly("peak_occupancy", &timing::PartitionBufferPollerStats::peak_occupancy)
+      .def_readonly("warnings_seen", &timing::PartitionBufferPollerStats::warnings_seen)
+      .def_readonly("errors_seen", &timing::PartitionBufferPollerStats::errors_seen)
+      ;
+
+  py::class_<timing::PartitionBufferPoller>(m, "PartitionBufferPoller")
+      .def(py::init<const timing::PartitionNode&, std::chrono::microseconds, std::chrono::microseconds, double>(),
+           py::arg("partition"), py::arg("min_interval") = std::chrono::microseconds(200), py::arg("max_interval") = std::chrono::microseconds(500000), py::arg("target_occupancy") = 0.5,
+           py::keep_alive<1, 2>())
+      .def("poll", [](timing::PartitionBufferPoller& p) { return as_array(p.poll()); })
+      .def("wait_and_poll", [](timing::PartitionBufferPoller& p) {
+             uhal::ValVector<uint32_t> lWords;
+             {
+               py::gil_scoped_release lRelease;
+               lWords = p.wait_and_poll();
+             }
+             return as_array(lWords);
+           })
+      .def("get_poll_interval", &timing::PartitionBufferPoller::get_poll_interval)
+      .def("get_stats", &timing::PartitionBufferPoller::get_stats, py::return_value_policy::copy)
+      .def("reset_stats", &timing::PartitionBufferPoller::reset_stats)
       ;
 }
 
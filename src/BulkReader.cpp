@@ -0,0 +1,137 @@
+#include "timing/BulkReader.hpp"
+
+#include "timing/toolbox.hpp"
+
+#include <set>
+
+namespace dunedaq {
+namespace timing {
+
+//-----------------------------------------------------------------------------
+BulkReader::BulkReader() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+BulkReader::~BulkReader() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+BulkReader::add_register(const std::string& name, const uhal::Node& node) {
+    m_registers.push_back({name, &node});
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+BulkReader::add_registers(const std::string& name, const uhal::Node& node) {
+    for (auto& lSubNode : node.getNodes()) m_registers.push_back({name + "." + lSubNode, &node.getNode(lSubNode)});
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+BulkReader::add_block(const std::string& name, const uhal::Node& node, uint32_t size) {
+    m_blocks.push_back({name, &node, size ? size : node.getSize()});
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+BulkReader::add_endpoint(const std::string& name, const EndpointNode& endpoint) {
+    m_endpoints.push_back({name, &endpoint, endpoint.getNode("csr.ctrl").getNodes(), endpoint.getNode("csr.stat").getNodes(), endpoint.getNode("ctrs").getSize()});
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+BulkSnapshot
+BulkReader::read() const {
+
+    // Queue every read first, so that each board is dispatched once
+    std::set<uhal::ClientInterface*> lClients;
+
+    std::vector<uhal::ValWord<uint32_t>> lRegisterValues;
+    for (auto& lRead : m_registers) {
+        lRegisterValues.push_back(lRead.node->read());
+        lClients.insert(&lRead.node->getClient());
+    }
+
+    std::vector<uhal::ValVector<uint32_t>> lBlockValues;
+    for (auto& lRead : m_blocks) {
+        lBlockValues.push_back(lRead.node->readBlock(lRead.size));
+        lClients.insert(&lRead.node->getClient());
+    }
+
+    struct EndpointValues {
+        uhal::ValVector<uint32_t> timestamp;
+        uhal::ValWord<uint32_t> event_counter;
+        uhal::ValWord<uint32_t> buffer_count;
+        std::vector<uhal::ValWord<uint32_t>> controls;
+        std::vector<uhal::ValWord<uint32_t>> status;
+        uhal::ValVector<uint32_t> counters;
+    };
+    std::vector<EndpointValues> lEndpointValues;
+    for (auto& lRead : m_endpoints) {
+        const EndpointNode& lEndpoint = *lRead.endpoint;
+        EndpointValues lValues;
+        lValues.timestamp = lEndpoint.getNode("tstamp").readBlock(2);
+        lValues.event_counter = lEndpoint.getNode("evtctr").read();
+        lValues.buffer_count = lEndpoint.getNode("buf.count").read();
+        for (auto& lNode : lRead.controls) lValues.controls.push_back(lEndpoint.getNode("csr.ctrl." + lNode).read());
+        for (auto& lNode : lRead.status) lValues.status.push_back(lEndpoint.getNode("csr.stat." + lNode).read());
+        lValues.counters = lEndpoint.getNode("ctrs").readBlock(lRead.number_of_counters);
+        lEndpointValues.push_back(lValues);
+        lClients.insert(&lEndpoint.getClient());
+    }
+
+    for (auto lClient : lClients) counted_dispatch(*lClient);
+
+    BulkSnapshot lSnapshot;
+    lSnapshot.dispatches = lClients.size();
+    lSnapshot.time = std::chrono::system_clock::now();
+
+    for (uint32_t i=0; i < m_registers.size(); ++i) lSnapshot.registers[m_registers.at(i).name] = lRegisterValues.at(i).value();
+    for (uint32_t i=0; i < m_blocks.size(); ++i) lSnapshot.blocks[m_blocks.at(i).name] = lBlockValues.at(i).value();
+
+    for (uint32_t i=0; i < m_endpoints.size(); ++i) {
+        const EndpointRead& lRead = m_endpoints.at(i);
+        const EndpointValues& lValues = lEndpointValues.at(i);
+
+        EndpointSnapshot lEndpoint;
+        for (uint32_t j=0; j < lRead.controls.size(); ++j) lEndpoint.controls[lRead.controls.at(j)] = lValues.controls.at(j).value();
+        for (uint32_t j=0; j < lRead.status.size(); ++j) lEndpoint.status[lRead.status.at(j)] = lValues.status.at(j).value();
+        lEndpoint.state = lEndpoint.status.at("ep_stat");
+        lEndpoint.partition = lEndpoint.controls.at("tgrp");
+        lEndpoint.address = lEndpoint.controls.at("addr");
+        lEndpoint.timestamp = tstamp2int(lValues.timestamp);
+        lEndpoint.event_counter = lValues.event_counter.value();
+        lEndpoint.buffer_count = lValues.buffer_count.value();
+        lEndpoint.buffer_error = lEndpoint.status.at("buf_err");
+        lEndpoint.counters = lValues.counters.value();
+        lSnapshot.endpoints[lRead.name] = lEndpoint;
+    }
+    return lSnapshot;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint32_t
+BulkReader::get_word_count() const {
+    uint32_t lWords = m_registers.size();
+    for (auto& lRead : m_blocks) lWords += lRead.size;
+    for (auto& lRead : m_endpoints) lWords += 4 + lRead.controls.size() + lRead.status.size() + lRead.number_of_counters;
+    return lWords;
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
@@ -24,7 +24,7 @@ CRTNode::enable(uint32_t partition, uint32_t command) const {
 	getNode("csr.ctrl.tgrp").write(partition);
     getNode("pulse.ctrl.cmd").write(command);
     getNode("pulse.ctrl.en").write(0x1);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -33,7 +33,7 @@ CRTNode::enable(uint32_t partition, uint32_t command) const {
 void
 CRTNode::disable() const {
 	getNode("pulse.ctrl.en").write(0x0);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -54,13 +54,26 @@ CRTNode::get_status(bool print_out) const {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+void
+CRTNode::report_status(StatusSink& sink) const {
+	auto lCRTRegs = read_sub_nodes(getNode(""));
+
+	sink.begin_section("CRT state");
+	sink.add_registers(lCRTRegs);
+	sink.add_register("Last pulse timestamp", ((uint64_t)lCRTRegs.at("pulse.ts_h").value() << 32) + lCRTRegs.at("pulse.ts_l").value());
+	sink.end_section();
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 uint64_t
 CRTNode::read_last_pulse_timestamp() const {
 
     auto lTimestampRegLow = getNode("pulse.ts_l").read();
     auto lTimestampRegHigh = getNode("pulse.ts_h").read();
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     return ((uint64_t)lTimestampRegHigh.value() << 32) + lTimestampRegLow.value();	
 }
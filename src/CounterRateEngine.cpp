@@ -0,0 +1,184 @@
+#include "timing/CounterRateEngine.hpp"
+
+#include "timing/toolbox.hpp"
+
+#include <map>
+
+namespace dunedaq {
+namespace timing {
+
+namespace {
+
+std::vector<std::string> command_labels(uint32_t size) {
+    std::vector<std::string> lLabels;
+    for (uint32_t i=0; i < size; ++i) {
+        auto lCommand = g_command_map.find(i);
+        lLabels.push_back(lCommand != g_command_map.end() ? lCommand->second : std::to_string(i));
+    }
+    return lLabels;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+CounterRateEngine::CounterRateEngine(std::chrono::milliseconds window) :
+    m_window(window) {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+CounterRateEngine::~CounterRateEngine() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+CounterRateEngine::add_counters(const std::string& name, const uhal::Node& counters, const std::vector<std::string>& labels) {
+    std::vector<std::string> lLabels = labels;
+    if (lLabels.empty()) {
+        for (uint32_t i=0; i < counters.getSize(); ++i) lLabels.push_back(std::to_string(i));
+    }
+
+    std::lock_guard<std::mutex> lLock(m_blocks_mutex);
+    m_blocks.push_back({name, &counters, lLabels, {}, {}});
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+CounterRateEngine::add_partition(const std::string& name, const PartitionNode& partition) {
+    add_counters(name + ".accepted", partition.getNode("actrs"), command_labels(partition.getNode("actrs").getSize()));
+    add_counters(name + ".rejected", partition.getNode("rctrs"), command_labels(partition.getNode("rctrs").getSize()));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+CounterRateEngine::add_fl_cmd_generator(const std::string& name, const FLCmdGeneratorNode& generator) {
+    add_counters(name + ".accepted", generator.getNode("actrs"));
+    add_counters(name + ".rejected", generator.getNode("rctrs"));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+CounterRateEngine::add_trigger_receiver(const std::string& name, const TriggerReceiverNode& receiver) {
+    add_counters(name, receiver.getNode("ctrs"));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+CounterRateEngine::add_endpoint(const std::string& name, const EndpointNode& endpoint) {
+    add_counters(name, endpoint.getNode("ctrs"), command_labels(endpoint.getNode("ctrs").getSize()));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+CounterRateEngine::sample(MonitoringHistory* history) {
+    std::lock_guard<std::mutex> lLock(m_blocks_mutex);
+
+    // Queue the reads of each board, then dispatch once per board
+    std::map<uhal::ClientInterface*, std::vector<std::pair<CounterBlock*, uhal::ValVector<uint32_t>>>> lReads;
+    for (auto& lBlock : m_blocks) {
+        lReads[&lBlock.node->getClient()].emplace_back(&lBlock, lBlock.node->readBlock(lBlock.labels.size()));
+    }
+
+    for (auto& lBoard : lReads) {
+        counted_dispatch(*lBoard.first);
+        auto lTime = std::chrono::steady_clock::now();
+        auto lSystemTime = std::chrono::system_clock::now();
+        for (auto& lRead : lBoard.second) {
+            update(*lRead.first, lRead.second.value(), lTime);
+            if (history) history->record_counters(lRead.first->name, lRead.first->last_values, lSystemTime);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+CounterRateEngine::get_info(timingfirmwareinfo::TimingCounterRatesVector& mon_data) const {
+    std::lock_guard<std::mutex> lLock(m_blocks_mutex);
+    for (auto& lBlock : m_blocks) mon_data.push_back(compute_rates(lBlock));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+timingfirmwareinfo::TimingCounterRates
+CounterRateEngine::get_rates(const std::string& name) const {
+    std::lock_guard<std::mutex> lLock(m_blocks_mutex);
+    for (auto& lBlock : m_blocks) {
+        if (lBlock.name == name) return compute_rates(lBlock);
+    }
+    throw CounterBlockNotFound(ERS_HERE, name);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<std::string>
+CounterRateEngine::get_names() const {
+    std::lock_guard<std::mutex> lLock(m_blocks_mutex);
+
+    std::vector<std::string> lNames;
+    for (auto& lBlock : m_blocks) lNames.push_back(lBlock.name);
+    return lNames;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+CounterRateEngine::update(CounterBlock& block, const std::vector<uint32_t>& values, std::chrono::steady_clock::time_point time) const {
+
+    CounterSample lSample{time, std::vector<uint64_t>(values.size(), 0)};
+    if (block.samples.size()) {
+        const CounterSample& lPrevious = block.samples.back();
+        // A reset counter restarts from zero rather than wrapping
+        for (uint32_t i=0; i < values.size(); ++i) {
+            lSample.totals.at(i) = lPrevious.totals.at(i) + counter_increase(block.last_values.at(i), values.at(i), time - lPrevious.time);
+        }
+    }
+    block.last_values = values;
+    block.samples.push_back(lSample);
+
+    // Keep the newest sample that is at least a window old, as the start of the window
+    while (block.samples.size() > 2 && time - block.samples.at(1).time >= m_window) block.samples.pop_front();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+timingfirmwareinfo::TimingCounterRates
+CounterRateEngine::compute_rates(const CounterBlock& block) const {
+    timingfirmwareinfo::TimingCounterRates lRates;
+    lRates.name = block.name;
+    lRates.labels = block.labels;
+    lRates.window = 0;
+    if (block.samples.empty()) return lRates;
+
+    const CounterSample& lFirst = block.samples.front();
+    const CounterSample& lLast = block.samples.back();
+    lRates.totals = lLast.totals;
+    lRates.window = std::chrono::duration<double>(lLast.time - lFirst.time).count();
+
+    for (uint32_t i=0; i < lLast.totals.size(); ++i) {
+        lRates.rates.push_back(lRates.window > 0 ? (lLast.totals.at(i) - lFirst.totals.at(i)) / lRates.window : 0.);
+    }
+    return lRates;
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
@@ -0,0 +1,85 @@
+#include "timing/DispatchAccounting.hpp"
+
+#include "uhal/ClientInterface.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+namespace dunedaq {
+namespace timing {
+
+namespace {
+
+// Innermost scope open on this thread
+thread_local DispatchScope* t_current_scope = nullptr;
+
+std::mutex g_dispatch_stats_mutex;
+std::map<std::string, DispatchStats> g_dispatch_stats;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+DispatchScope::DispatchScope(const std::string& key) :
+    m_key(key),
+    m_start(std::chrono::steady_clock::now()),
+    m_dispatches(0),
+    m_parent(t_current_scope) {
+    t_current_scope = this;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+DispatchScope::~DispatchScope() {
+    t_current_scope = m_parent;
+
+    auto lTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+
+    std::lock_guard<std::mutex> lLock(g_dispatch_stats_mutex);
+    auto lStats = g_dispatch_stats.emplace(m_key, DispatchStats{0, 0, 0, std::chrono::nanoseconds(0)}).first;
+    lStats->second.calls += 1;
+    lStats->second.dispatches += m_dispatches;
+    lStats->second.max_dispatches = std::max(lStats->second.max_dispatches, m_dispatches);
+    lStats->second.time += lTime;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+counted_dispatch(uhal::ClientInterface& client) {
+    for (DispatchScope* lScope = t_current_scope; lScope; lScope = lScope->m_parent) ++lScope->m_dispatches;
+    client.dispatch();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::map<std::string, DispatchStats>
+get_dispatch_stats() {
+    std::lock_guard<std::mutex> lLock(g_dispatch_stats_mutex);
+    return g_dispatch_stats;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+DispatchStats
+get_dispatch_stats(const std::string& key) {
+    std::lock_guard<std::mutex> lLock(g_dispatch_stats_mutex);
+    auto lStats = g_dispatch_stats.find(key);
+    return lStats != g_dispatch_stats.end() ? lStats->second : DispatchStats{0, 0, 0, std::chrono::nanoseconds(0)};
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+reset_dispatch_stats() {
+    std::lock_guard<std::mutex> lLock(g_dispatch_stats_mutex);
+    g_dispatch_stats.clear();
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
@@ -35,40 +35,28 @@ uint64_t
 EchoMonitorNode::send_echo_and_measure_delay(int64_t timeout) const {
 	
 	getNode("csr.ctrl.go").write(0x1);
-    getClient().dispatch();
-
-	auto start = std::chrono::high_resolution_clock::now();
-
-	std::chrono::milliseconds msSinceStart(0);
+    counted_dispatch(getClient());
 
 	uhal::ValWord<uint32_t> lDone;
+	uhal::ValWord<uint32_t> lTimeRxL, lTimeRxH, lTimeTxL, lTimeTxH;
 
-	while (msSinceStart.count() < timeout) {
-
-		auto now = std::chrono::high_resolution_clock::now();
-		msSinceStart = std::chrono::duration_cast<std::chrono::milliseconds>(now - start);
-
-		millisleep(100);
-		
+	// Timestamps are read along with the done flag, saving a round trip once the echo is back
+	auto lPoll = poll_until([&]() {
 		lDone = getNode("csr.stat.rx_done").read();
-        getClient().dispatch();
-		
-		TLOG_DEBUG(0) << "rx done: " << std::hex << lDone.value();
+		lTimeRxL = getNode("csr.rx_l").read();
+		lTimeRxH = getNode("csr.rx_h").read();
+		lTimeTxL = getNode("csr.tx_l").read();
+		lTimeTxH = getNode("csr.tx_h").read();
+		counted_dispatch(getClient());
+		return static_cast<bool>(lDone.value());
+	}, std::chrono::milliseconds(timeout));
 
-		if (lDone.value()) break; 
-	}
+	TLOG_DEBUG(0) << "rx done: " << std::hex << lDone.value() << std::dec << " after " << lPoll.polls << " polls, " << lPoll.elapsed.count() << " us";
 
-	if (!lDone.value()) {
+	if (!lPoll.success) {
         throw EchoTimeout(ERS_HERE, timeout);
 	}
 
-	auto lTimeRxL = getNode("csr.rx_l").read();
-	auto lTimeRxH = getNode("csr.rx_h").read();
-	auto lTimeTxL = getNode("csr.tx_l").read();
-	auto lTimeTxH = getNode("csr.tx_h").read();
-    
-    getClient().dispatch();
-
     uint64_t lTimeRx = ((uint64_t)lTimeRxH.value() << 32) + lTimeRxL.value();
     uint64_t lTimeTx = ((uint64_t)lTimeTxH.value() << 32) + lTimeTxL.value();
 
@@ -79,5 +67,31 @@ EchoMonitorNode::send_echo_and_measure_delay(int64_t timeout) const {
 }
 //-----------------------------------------------------------------------------
 
+
+//-----------------------------------------------------------------------------
+std::vector<uint64_t>
+EchoMonitorNode::send_echoes_and_measure_delays(uint32_t number_of_echoes, int64_t timeout) const {
+	std::vector<uint64_t> lDelays;
+	lDelays.reserve(number_of_echoes);
+
+	for (uint32_t i=0; i < number_of_echoes; ++i) {
+		lDelays.push_back(send_echo_and_measure_delay(timeout));
+	}
+	return lDelays;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+RTTStatistics
+EchoMonitorNode::measure_delay_statistics(uint32_t number_of_echoes, uint64_t max_spread, int64_t timeout) const {
+	auto lStats = compute_rtt_statistics(send_echoes_and_measure_delays(number_of_echoes, timeout), max_spread);
+
+	TLOG_DEBUG(0) << "RTT over " << lStats.samples << " echoes (" << lStats.accepted << " accepted): min " << lStats.min
+	              << ", median " << lStats.median << ", max " << lStats.max << ", stddev " << lStats.stddev;
+	return lStats;
+}
+//-----------------------------------------------------------------------------
+
 } // namespace timing
 } // namespace dunedaq
\ No newline at end of file
@@ -33,7 +33,7 @@ EndpointNode::enable(uint32_t partition, uint32_t address) const {
 	getNode("csr.ctrl.ctr_rst").write(0x0);
 	getNode("csr.ctrl.ep_en").write(0x1);
 	getNode("csr.ctrl.buf_en").write(0x1);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -43,7 +43,7 @@ void
 EndpointNode::disable() const {
 	getNode("csr.ctrl.ep_en").write(0x0);
     getNode("csr.ctrl.buf_en").write(0x0);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -63,6 +63,7 @@ EndpointNode::reset(uint32_t partition, uint32_t address) const {
 //-----------------------------------------------------------------------------
 std::string
 EndpointNode::get_status(bool print_out) const {
+	DispatchScope lDispatchScope("EndpointNode::get_status");
 	
 	std::stringstream lStatus;
 
@@ -74,7 +75,7 @@ EndpointNode::get_status(bool print_out) const {
 	auto lEPControl = read_sub_nodes(getNode("csr.ctrl"), false);
 	auto lEPState = read_sub_nodes(getNode("csr.stat"), false);
 	auto lEPCounters = getNode("ctrs").readBlock(g_command_number);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 
 	lEPSummary.push_back(std::make_pair("State", g_endpoint_state_map.at(lEPState.find("ep_stat")->second.value())));
 	lEPSummary.push_back(std::make_pair("Partition", std::to_string(lEPControl.find("tgrp")->second.value())));
@@ -102,11 +103,49 @@ EndpointNode::get_status(bool print_out) const {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+void
+EndpointNode::report_status(StatusSink& sink) const {
+	DispatchScope lDispatchScope("EndpointNode::report_status");
+
+	auto lEPTimestamp = getNode("tstamp").readBlock(2);
+	auto lEPEventCounter = getNode("evtctr").read();
+	auto lEPBufferCount = getNode("buf.count").read();
+	auto lEPControl = read_sub_nodes(getNode("csr.ctrl"), false);
+	auto lEPState = read_sub_nodes(getNode("csr.stat"), false);
+	auto lEPCounters = getNode("ctrs").readBlock(g_command_number);
+	counted_dispatch(getClient());
+
+	std::vector<std::string> lCommandLabels;
+	for (uint32_t i=0; i < g_command_number; ++i) lCommandLabels.push_back(g_command_map.at(i));
+
+	sink.begin_section("Endpoint summary");
+	sink.add_text("State", g_endpoint_state_map.at(lEPState.find("ep_stat")->second.value()));
+	sink.add_register("Partition", lEPControl.find("tgrp")->second.value());
+	sink.add_register("Address", lEPControl.find("addr")->second.value());
+	sink.add_text("Timestamp", format_timestamp(lEPTimestamp));
+	sink.add_register("Timestamp (hex)", tstamp2int(lEPTimestamp));
+	sink.add_register("EventCounter", lEPEventCounter.value());
+	sink.add_flag("Buffer error", lEPState.find("buf_err")->second.value());
+	sink.add_register("Buffer occupancy", lEPBufferCount.value());
+	sink.end_section();
+
+	sink.begin_section("Endpoint state");
+	sink.add_registers(lEPState);
+	sink.end_section();
+
+	sink.begin_section("Endpoint counters");
+	sink.add_counters("Counter", lCommandLabels, lEPCounters.value());
+	sink.end_section();
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 uint64_t
 EndpointNode::read_timestamp() const {
 	auto lTimestamp = getNode("tstamp").readBlock(2);
-	getClient().dispatch();
+	counted_dispatch(getClient());
     return tstamp2int(lTimestamp);
 }
 //-----------------------------------------------------------------------------
@@ -116,7 +155,7 @@ EndpointNode::read_timestamp() const {
 uint32_t
 EndpointNode::read_buffer_count() const {
 	auto lBufCount = getNode("buf.count").read();
-	getClient().dispatch();
+	counted_dispatch(getClient());
 	return lBufCount.value();
 }
 //-----------------------------------------------------------------------------
@@ -127,7 +166,7 @@ uhal::ValVector< uint32_t >
 EndpointNode::read_data_buffer(bool read_all) const {
 	
 	auto lBufCount = getNode("buf.count").read();
-	getClient().dispatch();
+	counted_dispatch(getClient());
 
 	TLOG_DEBUG(0) << "Words available in readout buffer:      " << format_reg_value(lBufCount);
 
@@ -144,7 +183,7 @@ EndpointNode::read_data_buffer(bool read_all) const {
 	}
 	
 	auto lBufData = getNode("buf.data").readBlock(lWordsToRead);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 
     return lBufData;
 }
@@ -187,12 +226,22 @@ EndpointNode::read_clock_frequency() const {
 uint32_t
 EndpointNode::read_version() const {
 	auto lBufCount = getNode("version").read();
-	getClient().dispatch();
+	counted_dispatch(getClient());
 	return lBufCount.value();
 }
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+std::vector<uint32_t>
+EndpointNode::read_command_counters() const {
+	auto lCounters = getNode("ctrs").readBlock(g_command_number);
+	counted_dispatch(getClient());
+	return lCounters.value();
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 void
 EndpointNode::get_info(timingendpointinfo::TimingEndpointInfo& mon_data) const {
@@ -203,7 +252,7 @@ EndpointNode::get_info(timingendpointinfo::TimingEndpointInfo& mon_data) const {
 	auto endpoint_control = read_sub_nodes(getNode("csr.ctrl"), false);
 	auto endpoint_state = read_sub_nodes(getNode("csr.stat"), false);
 	auto counters = getNode("ctrs").readBlock(g_command_number);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 	
 	mon_data.state = endpoint_state.at("ep_stat").value();
 	mon_data.ready = endpoint_state.at("ep_rdy").value();
@@ -1,10 +1,16 @@
 #include "timing/FLCmdGeneratorNode.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace dunedaq {
 namespace timing {
 
 UHAL_REGISTER_DERIVED_NODE(FLCmdGeneratorNode)
 
+const uint32_t FLCmdGeneratorNode::kMinCommandSpacing = 0x40;
+const uint32_t FLCmdGeneratorNode::kMaxCommandsPerDispatch = 64;
+
 //-----------------------------------------------------------------------------
 FLCmdGeneratorNode::FLCmdGeneratorNode(const uhal::Node& node) : TimingNode(node) {
 
@@ -32,21 +38,78 @@ FLCmdGeneratorNode::get_status(bool print_out) const {
 
 
 //-----------------------------------------------------------------------------
-void
-FLCmdGeneratorNode::send_fl_cmd(uint32_t command, uint32_t channel, const TimestampGeneratorNode& timestamp_gen_node) const {
-    getNode("sel").write(channel);
+std::vector<uint64_t>
+FLCmdGeneratorNode::send_fl_cmd(uint32_t command, uint32_t channel, const TimestampGeneratorNode& timestamp_gen_node, uint32_t number_of_commands) const {
+    DispatchScope lDispatchScope("FLCmdGeneratorNode::send_fl_cmd");
 
-    reset_sub_nodes(getNode("chan_ctrl"));
+    // Transactions queued for each command besides the padding: force edges and timestamp read
+    const uint32_t kSlotTransactions = 3;
+
+    auto lStart = std::chrono::steady_clock::now();
 
+    getNode("sel").write(channel);
+    reset_sub_nodes(getNode("chan_ctrl"), 0x0, false);
     getNode("chan_ctrl.type").write(command);
-    getNode("chan_ctrl.force").write(0x1);
-    auto lTStamp = timestamp_gen_node.read_raw_timestamp(false);
-    
-    getClient().dispatch();
-    
-    getNode("chan_ctrl.force").write(0x0);
-    getClient().dispatch();
-    TLOG() << "Command sent " << g_command_map.at(command) << "(" << format_reg_value(command) << ") from generator " << format_reg_value(channel) << " @time 0x" << tstamp2int(lTStamp) << " " << format_timestamp(lTStamp);
+
+    // Until a burst has been timed, assume the fastest possible bus: one transaction per clock tick
+    double lTicksPerTransaction = 1.;
+
+    std::vector<uhal::ValVector<uint32_t>> lRawTStamps;
+    std::vector<uint64_t> lTStamps;
+    lRawTStamps.reserve(number_of_commands);
+    lTStamps.reserve(number_of_commands);
+
+    while (lTStamps.size() < number_of_commands) {
+        uint32_t lChunk = std::min<uint32_t>(number_of_commands - lTStamps.size(), kMaxCommandsPerDispatch);
+        uint32_t lPadding = std::ceil(kMinCommandSpacing / lTicksPerTransaction);
+        lPadding = lPadding > kSlotTransactions ? lPadding - kSlotTransactions : 0;
+
+        auto lAccBefore = getNode("actrs").readBlock(getNode("actrs").getSize());
+        auto lRejBefore = getNode("rctrs").readBlock(getNode("rctrs").getSize());
+
+        // IPbus executes the packet in order: each timestamp is read between the force edges,
+        // and the padding reads keep consecutive commands kMinCommandSpacing apart
+        std::vector<uhal::ValVector<uint32_t>> lChunkTStamps;
+        for (uint32_t i=0; i < lChunk; ++i) {
+            getNode("chan_ctrl.force").write(0x1);
+            lChunkTStamps.push_back(timestamp_gen_node.read_raw_timestamp(false));
+            getNode("chan_ctrl.force").write(0x0);
+            for (uint32_t j=0; j < lPadding; ++j) getNode("sel").read();
+        }
+
+        auto lAccAfter = getNode("actrs").readBlock(getNode("actrs").getSize());
+        auto lRejAfter = getNode("rctrs").readBlock(getNode("rctrs").getSize());
+        counted_dispatch(getClient());
+
+        uint32_t lAccepted = lAccAfter.at(channel) - lAccBefore.at(channel);
+        uint32_t lRejected = lRejAfter.at(channel) - lRejBefore.at(channel);
+        if (lAccepted != lChunk || lRejected) {
+            throw FLCommandsRejected(ERS_HERE, channel, lTStamps.size() + lAccepted, number_of_commands, lRejected);
+        }
+
+        for (auto& lRawTStamp : lChunkTStamps) {
+            lRawTStamps.push_back(lRawTStamp);
+            lTStamps.push_back(tstamp2int(lRawTStamp));
+        }
+
+        // Time the bus on this chunk to size the padding of the next one
+        uint64_t lShortestSlot = 0;
+        for (size_t i = lTStamps.size() - lChunk + 1; i < lTStamps.size(); ++i) {
+            uint64_t lSlot = lTStamps.at(i) - lTStamps.at(i-1);
+            if (!lShortestSlot || lSlot < lShortestSlot) lShortestSlot = lSlot;
+        }
+        if (lShortestSlot) lTicksPerTransaction = std::max(1., static_cast<double>(lShortestSlot) / (kSlotTransactions + lPadding));
+    }
+
+    auto lElapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - lStart);
+
+    if (number_of_commands == 1) {
+        TLOG() << "Command sent " << g_command_map.at(command) << "(" << format_reg_value(command) << ") from generator " << format_reg_value(channel) << " @time 0x" << std::hex << lTStamps.front() << std::dec << " " << format_timestamp(lRawTStamps.front());
+    } else if (number_of_commands) {
+        TLOG() << number_of_commands << " x " << g_command_map.at(command) << "(" << format_reg_value(command) << ") sent from generator " << format_reg_value(channel)
+               << " in " << lElapsed.count() << " us, first @time 0x" << std::hex << lTStamps.front() << ", last @time 0x" << lTStamps.back() << std::dec;
+    }
+    return lTStamps;
 }
 //-----------------------------------------------------------------------------
 
@@ -63,7 +126,7 @@ FLCmdGeneratorNode::enable_fake_trigger(uint32_t channel, uint32_t divisor, uint
     getNode("chan_ctrl.rate_div_p").write(prescale);
     getNode("chan_ctrl.patt").write(poisson);
     getNode("chan_ctrl.en").write(1); // Start the command stream
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -85,7 +148,7 @@ FLCmdGeneratorNode::get_cmd_counters_table(bool print_out) const {
     std::stringstream lCountersTable;
     auto lAccCounters = getNode("actrs").readBlock(getNode("actrs").getSize());
     auto lRejCounters = getNode("rctrs").readBlock(getNode("actrs").getSize());
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     std::vector<uhal::ValVector<uint32_t>> lCountersContainer = {lAccCounters, lRejCounters};
 
@@ -101,7 +164,7 @@ void
 FLCmdGeneratorNode::get_info(timingfirmwareinfo::TimingFLCmdCountersVector& mon_data) const {
     auto accepted_counters = getNode("actrs").readBlock(getNode("actrs").getSize());
     auto rejected_counters = getNode("rctrs").readBlock(getNode("actrs").getSize());
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     //uint counters_number = getNode("actrs").getSize();
 
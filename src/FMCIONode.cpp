@@ -35,6 +35,7 @@ FMCIONode::get_status(bool print_out) const {
 //-----------------------------------------------------------------------------
 void
 FMCIONode::reset(const std::string& clock_config_file) const {
+	DispatchScope lDispatchScope("FMCIONode::reset");
 
 	writeSoftResetRegister();
 	
@@ -43,7 +44,7 @@ FMCIONode::reset(const std::string& clock_config_file) const {
 	// Reset PLL
 	getNode("csr.ctrl.pll_rst").write(0x1);
 	getNode("csr.ctrl.pll_rst").write(0x0);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 
 	CarrierType lCarrierType = convert_value_to_carrier_type(read_carrier_type());
 
@@ -67,7 +68,7 @@ FMCIONode::reset(const std::string& clock_config_file) const {
 
 	getNode("csr.ctrl.rst_lock_mon").write(0x1);
 	getNode("csr.ctrl.rst_lock_mon").write(0x0);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 	
 	TLOG() << "Reset done";
 }
@@ -1,10 +1,16 @@
 #include "timing/FrequencyCounterNode.hpp"
 
+#include <algorithm>
+
 namespace dunedaq {
 namespace timing {
 
 UHAL_REGISTER_DERIVED_NODE(FrequencyCounterNode)
 
+// Static data member initialization
+const double FrequencyCounterNode::kHzPerCount = 119.20928;
+const std::chrono::microseconds FrequencyCounterNode::kGatePeriod(8389);
+
 //-----------------------------------------------------------------------------
 FrequencyCounterNode::FrequencyCounterNode(const uhal::Node& node) : TimingNode(node) {
 }
@@ -31,27 +37,81 @@ FrequencyCounterNode::get_status(bool print_out) const {
 
 //-----------------------------------------------------------------------------
 std::vector<double>
-FrequencyCounterNode::measure_frequencies(uint8_t number_of_clocks) const {
-	std::vector<double> lFrequencies;
-
-	for (uint8_t i=0; i < number_of_clocks; ++i) {
-		getNode("ctrl.chan_sel").write(i);
-		getNode("ctrl.en_crap_mode").write(0);
-		getClient().dispatch();
-		
-		millisleep(2000);
-
-		uhal::ValWord<uint32_t> lFrequency = getNode("freq.count").read();
-		uhal::ValWord<uint32_t> lFrequencyValid = getNode("freq.valid").read();
-		getClient().dispatch();
-
-		if (lFrequencyValid.value()) {
-			double freq = lFrequency.value() * 119.20928 / 1000000;
-			lFrequencies.push_back(freq);
-		} else {
-			lFrequencies.push_back(-1);
-		}
+FrequencyCounterNode::measure_frequencies(uint8_t number_of_clocks, std::chrono::milliseconds timeout) const {
+	return measure_frequencies({this}, {number_of_clocks}, timeout).front();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<std::vector<double>>
+FrequencyCounterNode::measure_frequencies(const std::vector<const FrequencyCounterNode*>& counters, const std::vector<uint8_t>& number_of_clocks, std::chrono::milliseconds timeout) {
+
+	struct CounterState {
+		const FrequencyCounterNode* node;
+		size_t index;
+		uint8_t channel;
+		uint8_t number_of_clocks;
+		std::chrono::steady_clock::time_point switched;
+	};
+
+	std::vector<std::vector<double>> lFrequencies(counters.size());
+	std::vector<CounterState> lStates;
+
+	auto lSelect = [](CounterState& state) {
+		state.node->getNode("ctrl.chan_sel").write(state.channel);
+		state.node->getNode("ctrl.en_crap_mode").write(0);
+		counted_dispatch(state.node->getClient());
+		state.switched = std::chrono::steady_clock::now();
+	};
+
+	uint8_t lMaxClocks(0);
+	for (size_t i=0; i < counters.size(); ++i) {
+		uint8_t lClocks = i < number_of_clocks.size() ? number_of_clocks.at(i) : 0;
+		lMaxClocks = std::max(lMaxClocks, lClocks);
+		if (!lClocks) continue;
+
+		lStates.push_back({counters.at(i), i, 0, lClocks, {}});
+		lSelect(lStates.back());
 	}
+
+	// The measurement window in flight when the channel changes is partial,
+	// and valid may still refer to the previous channel: skip two windows.
+	const auto lSettle = 2 * kGatePeriod;
+
+	auto lAllDone = [&]() {
+		bool lDone = true;
+		for (auto& lState : lStates) {
+			if (lState.channel >= lState.number_of_clocks) continue;
+			lDone = false;
+
+			auto lElapsed = std::chrono::steady_clock::now() - lState.switched;
+			if (lElapsed < lSettle) continue;
+
+			uhal::ValWord<uint32_t> lFrequency = lState.node->getNode("freq.count").read();
+			uhal::ValWord<uint32_t> lFrequencyValid = lState.node->getNode("freq.valid").read();
+			counted_dispatch(lState.node->getClient());
+
+			double lFreq;
+			if (lFrequencyValid.value()) {
+				lFreq = lFrequency.value() * kHzPerCount / 1000000;
+			} else if (lElapsed >= timeout) {
+				lFreq = -1;
+			} else {
+				continue;
+			}
+
+			lFrequencies.at(lState.index).push_back(lFreq);
+			TLOG_DEBUG(0) << lState.node->getPath() << " channel " << (uint32_t)lState.channel << ": " << lFreq << " MHz after " << std::chrono::duration_cast<std::chrono::milliseconds>(lElapsed).count() << " ms";
+
+			if (++lState.channel < lState.number_of_clocks) lSelect(lState);
+		}
+		return lDone;
+	};
+
+	// Every channel completes within its own timeout; the overall limit is only a backstop
+	poll_until(lAllDone, (lMaxClocks + 1) * std::chrono::duration_cast<std::chrono::microseconds>(timeout), 0, std::chrono::milliseconds(2));
+
 	return lFrequencies;
 }
 //-----------------------------------------------------------------------------
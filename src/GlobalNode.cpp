@@ -75,42 +75,27 @@ std::string GlobalNode::get_status(bool print_out) const {
 void
 GlobalNode::enable_upstream_endpoint(uint32_t timeout) {
 	getNode("csr.ctrl.ep_en").write(0x0);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 	getNode("csr.ctrl.ep_en").write(0x1);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 
 	TLOG() << "Upstream endpoint reset, waiting for lock";
 
-	auto start = std::chrono::high_resolution_clock::now();
-
-	std::chrono::milliseconds msSinceStart(0);
-
 	uhal::ValWord<uint32_t> lEptStat;
 	uhal::ValWord<uint32_t> lEptRdy;
 
 	// Wait for the endpoint to be happy
-	while (msSinceStart.count() < timeout) {
-		auto now = std::chrono::high_resolution_clock::now();
-		msSinceStart = std::chrono::duration_cast<std::chrono::milliseconds>(now - start);
-
-		millisleep(100);
-		
+	auto lPoll = poll_until([this, &lEptStat, &lEptRdy]() {
 		lEptStat = getNode("csr.stat.ep_stat").read();
 		lEptRdy = getNode("csr.stat.ep_rdy").read();
-        
-        getClient().dispatch();
+		counted_dispatch(getClient());
+		return static_cast<bool>(lEptRdy.value());
+	}, std::chrono::milliseconds(timeout));
 
-        if (lEptRdy.value()) {
-        	TLOG() << "Endpoint locked: state= " << format_reg_value(lEptStat);
-            return;
-        }
-	}
-	
-	if (!lEptRdy.value()) {
+	if (!lPoll.success) {
 		throw UpstreamEndpointFailedToLock(ERS_HERE, format_reg_value(lEptStat));
-    } else {
-        TLOG() << "Endpoint locked: state= " << format_reg_value(lEptStat);
-    }
+	}
+	TLOG() << "Endpoint locked: state= " << format_reg_value(lEptStat) << " after " << lPoll.elapsed.count() << " us";
 }
 //-----------------------------------------------------------------------------
 
@@ -320,6 +320,7 @@ I2CMasterNode::scan() const {
 //-----------------------------------------------------------------------------
 void 
 I2CMasterNode::reset() const {
+    DispatchScope lDispatchScope("I2CMasterNode::reset");
     // Resets the I2C bus
     //
     // This function does the following:
@@ -331,7 +332,7 @@ I2CMasterNode::reset() const {
     auto ctrl = getNode(kCtrlNode).read();
     auto preHi = getNode(kPreHiNode).read();
     auto preLo = getNode(kPreLoNode).read();
-    getClient().dispatch();
+    counted_dispatch(getClient());
     
     bool lFullReset(false);
 
@@ -340,25 +341,25 @@ I2CMasterNode::reset() const {
     if ( lFullReset ) {
         // disable the I2C core
         getNode(kCtrlNode).write(0x00);
-        getClient().dispatch();
+        counted_dispatch(getClient());
         // set the clock prescale
         getNode(kPreHiNode).write((m_clock_prescale & 0xff00) >> 8);
-        // getClient().dispatch();
+        // counted_dispatch(getClient());
         getNode(kPreLoNode).write(m_clock_prescale & 0xff);
-        // getClient().dispatch();
+        // counted_dispatch(getClient());
         // set all writable bus-master registers to default values
         getNode(kTxNode).write(0x00);
         getNode(kCmdNode).write(0x00);
-        getClient().dispatch();
+        counted_dispatch(getClient());
 
         // enable the I2C core
         getNode(kCtrlNode).write(0x80);
-        getClient().dispatch();
+        counted_dispatch(getClient());
     } else {
         // set all writable bus-master registers to default values
         getNode(kTxNode).write(0x00);
         getNode(kCmdNode).write(0x00);
-        getClient().dispatch();
+        counted_dispatch(getClient());
     }
 }
 //-----------------------------------------------------------------------------
@@ -376,14 +377,14 @@ I2CMasterNode::send_i2c_command_and_read_data( uint8_t command ) const  {
 
     // Force the read bit high and set them cmd bits
     getNode(kCmdNode).write( lFullCmd );
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     // Wait for transaction to finish. Require idle bus at the end if stop bit is high)
     wait_until_finished(/*req ack*/ false, command & kStopCmd);
 
     // Pull the data out of the rx register.
     uhal::ValWord<uint32_t> lResult = getNode(kRxNode).read();
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     TLOG_DEBUG(2) << "<< receive data      = " << format_reg_value((uint32_t)lResult);
 
@@ -406,13 +407,13 @@ I2CMasterNode::send_i2c_command_and_write_data( uint8_t command, uint8_t data )
 
     // write the payload
     getNode(kTxNode).write( data );
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     // Force the write bit high and set them cmd bits
     getNode(kCmdNode).write( lFullCmd );
 
     // Run the commands and wait for transaction to finish
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     // Wait for transaction to finish. Require idle bus at the end if stop bit is high
     wait_until_finished(/*req hack*/ true, /*requ idle*/ command & kStopCmd);
@@ -439,7 +440,7 @@ void I2CMasterNode::wait_until_finished(bool aRequireAcknowledgement, bool aRequ
         usleep(10);
         // Get the status
         uhal::ValWord<uint32_t> i2c_status = lStatusNode.read();
-        getClient().dispatch();
+        counted_dispatch(getClient());
 
         lReceivedAcknowledge = !(i2c_status & kReceivedAckBit);
         lBusy = (i2c_status & kBusyBit);
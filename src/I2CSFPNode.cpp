@@ -378,6 +378,40 @@ I2CSFPSlave::get_status(bool print_out) const {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+void
+I2CSFPSlave::report_status(StatusSink& sink) const {
+    sfp_reachable();
+
+    sink.begin_section("SFP status");
+    sink.add_text("Vendor", read_vendor_name());
+    sink.add_text("Part number", read_vendor_part_number());
+    sink.add_text("Serial number", read_serial_number());
+
+    const bool lDDMSupported = read_ddm_support_bit();
+    const bool lAddressSwap = lDDMSupported && read_i2c_reg_addressSwapBit();
+    sink.add_flag("DDM supported", lDDMSupported);
+    if (!lDDMSupported || lAddressSwap) {
+        if (lAddressSwap) sink.add_flag("DDM address swap", lAddressSwap);
+        sink.end_section();
+        return;
+    }
+
+    sink.add_number("Temperature", read_temperature(), "C");
+    sink.add_number("Supply voltage", read_voltage(), "V");
+    sink.add_number("Rx power", read_rx_ower(), "uW");
+    sink.add_number("Tx power", read_tx_power(), "uW");
+    sink.add_number("Tx current", read_current(), "uA");
+
+    const bool lSoftTxControl = read_soft_tx_control_support_bit();
+    sink.add_flag("Soft Tx disable supported", lSoftTxControl);
+    if (lSoftTxControl) sink.add_flag("Tx disable bit", read_soft_tx_control_state());
+    sink.add_flag("Tx disable pin", read_tx_disable_pin_state());
+    sink.end_section();
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 void
 I2CSFPSlave::get_info(timinghardwareinfo::TimingSFPMonitorData& mon_data) const {
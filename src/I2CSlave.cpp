@@ -132,5 +132,13 @@ I2CSlave::get_master_id() const {
 }
 //-----------------------------------------------------------------------------
 
+
+//-----------------------------------------------------------------------------
+const I2CMasterNode&
+I2CSlave::get_master() const {
+    return *m_i2c_master;
+}
+//-----------------------------------------------------------------------------
+
 } // namespace timing
 } // namespace dunedaq
\ No newline at end of file
@@ -30,7 +30,7 @@ IONode::~IONode() {
 uint32_t
 IONode::read_board_type() const {
 	uhal::ValWord<uint32_t> lBoardType = getNode("config.board_type").read();
-    getClient().dispatch();
+    counted_dispatch(getClient());
     return lBoardType.value();  
 }
 //-----------------------------------------------------------------------------
@@ -40,7 +40,7 @@ IONode::read_board_type() const {
 uint32_t
 IONode::read_carrier_type() const {
 	uhal::ValWord<uint32_t> lCarrierType = getNode("config.carrier_type").read();
-    getClient().dispatch();
+    counted_dispatch(getClient());
     return lCarrierType.value();
 }
 //-----------------------------------------------------------------------------
@@ -50,7 +50,7 @@ IONode::read_carrier_type() const {
 uint32_t
 IONode::read_design_type() const {
 	uhal::ValWord<uint32_t> lDesignType = getNode("config.design_type").read();
-	getClient().dispatch();
+	counted_dispatch(getClient());
 	return lDesignType.value();
 }
 //-----------------------------------------------------------------------------
@@ -229,6 +229,21 @@ IONode::read_clock_frequencies() const {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+std::vector<std::vector<double>>
+IONode::read_clock_frequencies(const std::vector<const IONode*>& io_nodes, std::chrono::milliseconds timeout) {
+	std::vector<const FrequencyCounterNode*> lCounters;
+	std::vector<uint8_t> lNumberOfClocks;
+
+	for (auto lIONode : io_nodes) {
+		lCounters.push_back(&lIONode->getNode<FrequencyCounterNode>("freq"));
+		lNumberOfClocks.push_back(lIONode->m_clock_names.size());
+	}
+	return FrequencyCounterNode::measure_frequencies(lCounters, lNumberOfClocks, timeout);
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 std::string
 IONode::get_clock_frequencies_table(bool print_out) const {
@@ -300,7 +315,7 @@ IONode::get_pll_status(bool print_out) const {
 void 
 IONode::writeSoftResetRegister() const {
 	getNode("csr.ctrl.soft_rst").write(0x1);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -0,0 +1,154 @@
+#include "timing/MonitoringCollector.hpp"
+
+#include "timing/toolbox.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace dunedaq {
+namespace timing {
+
+//-----------------------------------------------------------------------------
+MonitoringCollector::MonitoringCollector(PublishFunction publish) :
+    m_publish(publish),
+    m_running(false) {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+MonitoringCollector::~MonitoringCollector() {
+    stop();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+MonitoringCollector::add_task(const std::string& name, const std::string& device, std::chrono::milliseconds period, CollectFunction collect) {
+    std::lock_guard<std::mutex> lLock(m_run_mutex);
+    if (m_running) {
+        throw UnsupportedFunction(ERS_HERE, "Monitoring tasks cannot be added while the collector is running");
+    }
+
+    auto& lDeviceMutex = m_device_mutexes[device];
+    if (!lDeviceMutex) lDeviceMutex.reset(new std::mutex());
+
+    m_tasks.push_back(std::unique_ptr<MonitoringTask>(new MonitoringTask{name, period, collect, {"", {}, 0, 0}, lDeviceMutex.get()}));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+MonitoringCollector::start() {
+    std::lock_guard<std::mutex> lLock(m_run_mutex);
+    if (m_running) return;
+
+    m_running = true;
+    for (auto& lTask : m_tasks) {
+        m_threads.emplace_back(&MonitoringCollector::run_task, this, std::ref(*lTask));
+    }
+    TLOG() << "Monitoring collector started with " << m_tasks.size() << " tasks";
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+MonitoringCollector::stop() {
+    {
+        std::lock_guard<std::mutex> lLock(m_run_mutex);
+        if (!m_running) return;
+        m_running = false;
+    }
+    m_run_condition.notify_all();
+
+    for (auto& lThread : m_threads) lThread.join();
+    m_threads.clear();
+    TLOG() << "Monitoring collector stopped";
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+MonitoringSnapshot
+MonitoringCollector::get_snapshot(const std::string& name) const {
+    const MonitoringTask& lTask = find_task(name);
+
+    std::lock_guard<std::mutex> lLock(m_snapshot_mutex);
+    return lTask.latest;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<std::string>
+MonitoringCollector::get_task_names() const {
+    std::vector<std::string> lNames;
+    for (auto& lTask : m_tasks) lNames.push_back(lTask->name);
+    return lNames;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+MonitoringCollector::run_task(MonitoringTask& task) {
+
+    auto lNextCollection = std::chrono::steady_clock::now();
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lLock(m_run_mutex);
+            if (m_run_condition.wait_until(lLock, lNextCollection, [this]() { return !m_running; })) return;
+        }
+
+        // Keep to the period; a collection that overruns it is followed straight away by the next one
+        lNextCollection = std::max(lNextCollection + task.period, std::chrono::steady_clock::now());
+
+        std::string lPayload;
+        try {
+            std::lock_guard<std::mutex> lDeviceLock(*task.device_mutex);
+            lPayload = task.collect();
+        } catch (const std::exception& e) {
+            ers::warning(MonitoringTaskFailed(ERS_HERE, task.name, e.what()));
+
+            std::lock_guard<std::mutex> lLock(m_snapshot_mutex);
+            ++task.latest.failures;
+            continue;
+        }
+
+        MonitoringSnapshot lSnapshot;
+        {
+            std::lock_guard<std::mutex> lLock(m_snapshot_mutex);
+            task.latest.payload = std::move(lPayload);
+            task.latest.time_gathered = std::chrono::system_clock::now();
+            ++task.latest.sequence;
+            lSnapshot = task.latest;
+        }
+
+        if (m_publish) {
+            try {
+                m_publish(task.name, lSnapshot);
+            } catch (const std::exception& e) {
+                ers::warning(MonitoringTaskFailed(ERS_HERE, task.name, e.what()));
+            }
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+const MonitoringCollector::MonitoringTask&
+MonitoringCollector::find_task(const std::string& name) const {
+    for (auto& lTask : m_tasks) {
+        if (lTask->name == name) return *lTask;
+    }
+    throw MonitoringTaskNotFound(ERS_HERE, name);
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
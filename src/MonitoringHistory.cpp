@@ -0,0 +1,239 @@
+#include "timing/MonitoringHistory.hpp"
+
+#include "timing/toolbox.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace dunedaq {
+namespace timing {
+
+namespace {
+
+// Every delta takes at most two 10 byte varints
+const size_t kMaxEntrySize = 20;
+
+int64_t to_us(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point from_us(int64_t us) {
+    return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(us)));
+}
+
+void put_varint(std::vector<uint8_t>& buffer, uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t get_varint(const std::vector<uint8_t>& buffer, size_t& position) {
+    uint64_t lValue = 0;
+    for (uint32_t lShift=0;; lShift += 7) {
+        uint8_t lByte = buffer.at(position++);
+        lValue |= static_cast<uint64_t>(lByte & 0x7f) << lShift;
+        if (!(lByte & 0x80)) return lValue;
+    }
+}
+
+// Small positive and negative deltas both map to small unsigned values
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+MonitoringHistory::MonitoringHistory(uint32_t block_size, uint32_t blocks_per_series) :
+    m_block_size(std::max<uint32_t>(block_size, kMaxEntrySize)),
+    m_blocks_per_series(std::max(blocks_per_series, 1u)) {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+MonitoringHistory::~MonitoringHistory() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+bool
+MonitoringHistory::record(const std::string& key, uint64_t value, std::chrono::system_clock::time_point time) {
+    std::lock_guard<std::mutex> lLock(m_series_mutex);
+
+    auto lSeries = m_series.find(key);
+    if (lSeries == m_series.end()) {
+        lSeries = m_series.emplace(key, Series{{}, 0, 0, 0}).first;
+    } else if (lSeries->second.last_value == value) {
+        return false;
+    }
+
+    append(lSeries->second, to_us(time), value);
+    return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint32_t
+MonitoringHistory::record_counters(const std::string& prefix, const std::vector<uint32_t>& values, std::chrono::system_clock::time_point time) {
+    uint32_t lStored = 0;
+    for (uint32_t i=0; i < values.size(); ++i) {
+        if (record(prefix + "." + std::to_string(i), values.at(i), time)) ++lStored;
+    }
+    return lStored;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<HistorySample>
+MonitoringHistory::query(const std::string& key, std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to) const {
+    std::lock_guard<std::mutex> lLock(m_series_mutex);
+    return decode(find_series(key), to_us(from), to_us(to));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+HistorySample
+MonitoringHistory::value_at(const std::string& key, std::chrono::system_clock::time_point time) const {
+    std::lock_guard<std::mutex> lLock(m_series_mutex);
+
+    const Series& lSeries = find_series(key);
+    auto lSamples = decode(lSeries, std::numeric_limits<int64_t>::min(), to_us(time));
+    if (lSamples.size()) return lSamples.back();
+
+    // Before the oldest change still kept, the oldest change is the best there is
+    return decode(lSeries, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()).front();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+double
+MonitoringHistory::rate(const std::string& key, std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to) const {
+    if (to <= from) return 0.;
+
+    std::lock_guard<std::mutex> lLock(m_series_mutex);
+    auto lSamples = decode(find_series(key), std::numeric_limits<int64_t>::min(), to_us(to));
+    if (lSamples.empty()) return 0.;
+
+    // Start from the value the counter had at the start of the window
+    auto lBaseline = std::upper_bound(lSamples.begin(), lSamples.end(), from, [](std::chrono::system_clock::time_point time, const HistorySample& sample) { return time < sample.time; });
+    if (lBaseline != lSamples.begin()) --lBaseline;
+
+    uint64_t lIncrease = 0;
+    for (auto lSample = lBaseline + 1; lSample < lSamples.end(); ++lSample) {
+        lIncrease += counter_increase((lSample - 1)->value, lSample->value, lSample->time - (lSample - 1)->time);
+    }
+    return lIncrease / std::chrono::duration<double>(to - from).count();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<std::string>
+MonitoringHistory::get_keys() const {
+    std::lock_guard<std::mutex> lLock(m_series_mutex);
+
+    std::vector<std::string> lKeys;
+    for (auto& lSeries : m_series) lKeys.push_back(lSeries.first);
+    return lKeys;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+size_t
+MonitoringHistory::get_memory_usage() const {
+    std::lock_guard<std::mutex> lLock(m_series_mutex);
+
+    size_t lBytes = 0;
+    for (auto& lSeries : m_series) {
+        for (auto& lBlock : lSeries.second.blocks) lBytes += sizeof(Block) + lBlock.deltas.capacity();
+    }
+    return lBytes;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+MonitoringHistory::append(Series& series, int64_t time, uint64_t value) {
+
+    // Samples are kept in order, even if the clock stepped back
+    if (series.blocks.size()) time = std::max(time, series.last_time);
+
+    bool lNewBlock = series.blocks.empty() || series.blocks.at(series.current).deltas.size() + kMaxEntrySize > m_block_size;
+
+    if (lNewBlock) {
+        if (series.blocks.size() < m_blocks_per_series) {
+            series.blocks.push_back(Block());
+            series.blocks.back().deltas.reserve(m_block_size);
+            series.current = series.blocks.size() - 1;
+        } else {
+            // Overwrite the oldest block, keeping its buffer
+            series.current = (series.current + 1) % series.blocks.size();
+            series.blocks.at(series.current).deltas.clear();
+        }
+        Block& lBlock = series.blocks.at(series.current);
+        lBlock.first_time = time;
+        lBlock.first_value = value;
+    } else {
+        std::vector<uint8_t>& lDeltas = series.blocks.at(series.current).deltas;
+        put_varint(lDeltas, static_cast<uint64_t>(time - series.last_time));
+        put_varint(lDeltas, zigzag(static_cast<int64_t>(value - series.last_value)));
+    }
+
+    series.last_time = time;
+    series.last_value = value;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<HistorySample>
+MonitoringHistory::decode(const Series& series, int64_t from, int64_t to) const {
+    std::vector<HistorySample> lSamples;
+
+    const uint32_t lNumberOfBlocks = series.blocks.size();
+    for (uint32_t i=0; i < lNumberOfBlocks; ++i) {
+        const Block& lBlock = series.blocks.at((series.current + 1 + i) % lNumberOfBlocks);
+        if (lBlock.first_time > to) break;
+
+        int64_t lTime = lBlock.first_time;
+        uint64_t lValue = lBlock.first_value;
+        if (lTime >= from) lSamples.push_back({from_us(lTime), lValue});
+
+        size_t lPosition = 0;
+        while (lPosition < lBlock.deltas.size()) {
+            lTime += get_varint(lBlock.deltas, lPosition);
+            lValue += static_cast<uint64_t>(unzigzag(get_varint(lBlock.deltas, lPosition)));
+            if (lTime > to) return lSamples;
+            if (lTime >= from) lSamples.push_back({from_us(lTime), lValue});
+        }
+    }
+    return lSamples;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+const MonitoringHistory::Series&
+MonitoringHistory::find_series(const std::string& key) const {
+    auto lSeries = m_series.find(key);
+    if (lSeries == m_series.end()) throw HistorySeriesNotFound(ERS_HERE, key);
+    return lSeries->second;
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
@@ -34,6 +34,7 @@ PC059IONode::get_status(bool print_out) const {
 //-----------------------------------------------------------------------------
 void
 PC059IONode::reset(int32_t fanout_mode, const std::string& clock_config_file) const {
+	DispatchScope lDispatchScope("PC059IONode::reset");
 	
 	// Soft reset
 	writeSoftResetRegister();
@@ -50,7 +51,7 @@ PC059IONode::reset(int32_t fanout_mode, const std::string& clock_config_file) co
 	getNode("csr.ctrl.rst_i2cmux").write(0x1);
 	getNode("csr.ctrl.rst_i2cmux").write(0x0);
 
-	getClient().dispatch();
+	counted_dispatch(getClient());
 
 	// enclustra i2c switch stuff
 	try {
@@ -66,7 +67,7 @@ PC059IONode::reset(int32_t fanout_mode, const std::string& clock_config_file) co
 	configure_pll(lClockConfigFile);
 	
 	getNode("csr.ctrl.mux").write(0);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 	
 	auto lSFPExp = get_i2c_device<I2CExpanderSlave>(m_uid_i2c_bus, "SFPExpander");
 	
@@ -84,7 +85,7 @@ PC059IONode::reset(int32_t fanout_mode, const std::string& clock_config_file) co
 
 	getNode("csr.ctrl.rst_lock_mon").write(0x1);
 	getNode("csr.ctrl.rst_lock_mon").write(0x0);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 
 	TLOG() << "Reset done";
 }
@@ -103,7 +104,7 @@ PC059IONode::reset(const std::string& clock_config_file) const {
 void
 PC059IONode::switch_sfp_mux_channel(uint32_t sfp_id) const {
 	getNode("csr.ctrl.mux").write(sfp_id);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 	
 	TLOG_DEBUG(0) << "SFP input mux set to " << format_reg_value(read_active_sfp_mux_channel());
 }
@@ -114,20 +115,41 @@ PC059IONode::switch_sfp_mux_channel(uint32_t sfp_id) const {
 uint32_t
 PC059IONode::read_active_sfp_mux_channel() const {
 	auto lActiveSFPMUXChannel = getNode("csr.ctrl.mux").read();
-	getClient().dispatch();
+	counted_dispatch(getClient());
 	return lActiveSFPMUXChannel.value();
 }
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+uint32_t
+PC059IONode::get_number_of_sfp_mux_channels() const {
+	uint32_t lMask = getNode("csr.stat.sfp_los").getMask();
+	uint32_t lChannels = 0;
+	for (; lMask; lMask &= lMask - 1) ++lChannels;
+	return lChannels;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint32_t
+PC059IONode::read_sfp_los_flags() const {
+	auto lLOS = getNode("csr.stat.sfp_los").read();
+	counted_dispatch(getClient());
+	return lLOS.value();
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 void
 PC059IONode::switch_sfp_i2c_mux_channel(uint32_t sfp_id) const {
 
 	getNode("csr.ctrl.rst_i2cmux").write(0x1);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 	getNode("csr.ctrl.rst_i2cmux").write(0x0);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 	millisleep(100);
 	
 	
@@ -5,6 +5,22 @@ namespace timing {
 
 UHAL_REGISTER_DERIVED_NODE(PDIMasterNode)
 
+// Static data member initialization
+const uint32_t PDIMasterNode::kNumberOfPartitions = 4;
+
+namespace {
+// Partition node paths, built once rather than on every lookup
+const std::vector<std::string>&
+get_partition_node_names() {
+    static const std::vector<std::string> lNames = []() {
+        std::vector<std::string> lNames;
+        for (uint32_t i=0; i < PDIMasterNode::kNumberOfPartitions; ++i) lNames.push_back("master.partition" + std::to_string(i));
+        return lNames;
+    }();
+    return lNames;
+}
+}
+
 //-----------------------------------------------------------------------------
 PDIMasterNode::PDIMasterNode(const uhal::Node& node) : MasterNode(node) {
 }
@@ -43,9 +59,9 @@ PDIMasterNode::switch_endpoint_sfp(uint32_t address, bool turn_on) const {
 
 //-----------------------------------------------------------------------------
 void
-PDIMasterNode::enable_upstream_endpoint() const {
+PDIMasterNode::enable_upstream_endpoint(uint32_t timeout) const {
     auto lGlobal = getNode<GlobalNode>("master.global");
-    lGlobal.enable_upstream_endpoint();
+    lGlobal.enable_upstream_endpoint(timeout);
 }
 //-----------------------------------------------------------------------------
 
@@ -53,6 +69,15 @@ PDIMasterNode::enable_upstream_endpoint() const {
 //-----------------------------------------------------------------------------
 uint32_t
 PDIMasterNode::measure_endpoint_rtt(uint32_t address, bool control_sfp) const {
+    return measure_endpoint_rtt_statistics(address, 1, control_sfp).median;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+RTTStatistics
+PDIMasterNode::measure_endpoint_rtt_statistics(uint32_t address, uint32_t number_of_echoes, bool control_sfp) const {
+    DispatchScope lDispatchScope("PDIMasterNode::measure_endpoint_rtt_statistics");
 
     auto vlCmdNode = getNode<VLCmdGeneratorNode>("master.acmd");
     auto lGlobal = getNode<GlobalNode>("master.global");
@@ -70,10 +95,14 @@ PDIMasterNode::measure_endpoint_rtt(uint32_t address, bool control_sfp) const {
 
     lGlobal.enable_upstream_endpoint();
         
-    uint32_t lEndpointRTT = lEcho.send_echo_and_measure_delay();
+    RTTStatistics lEndpointRTT = lEcho.measure_delay_statistics(number_of_echoes);
     
     if (control_sfp) vlCmdNode.switch_endpoint_sfp(address, false);
 
+    if (lEndpointRTT.unstable) {
+        TLOG() << "Endpoint " << address << " RTT unstable: " << lEndpointRTT.min << "-" << lEndpointRTT.max
+               << ", " << lEndpointRTT.samples - lEndpointRTT.accepted << "/" << lEndpointRTT.samples << " echoes rejected";
+    }
     return lEndpointRTT;
 }
 //-----------------------------------------------------------------------------
@@ -82,6 +111,7 @@ PDIMasterNode::measure_endpoint_rtt(uint32_t address, bool control_sfp) const {
 //-----------------------------------------------------------------------------
 void
 PDIMasterNode::apply_endpoint_delay(uint32_t address, uint32_t coarse_delay, uint32_t fine_delay, uint32_t phase_delay, bool measure_rtt, bool control_sfp) const {
+    DispatchScope lDispatchScope("PDIMasterNode::apply_endpoint_delay");
     
     auto vlCmdNode = getNode<VLCmdGeneratorNode>("master.acmd");
     auto lGlobal = getNode<GlobalNode>("master.global");
@@ -123,10 +153,16 @@ PDIMasterNode::apply_endpoint_delay(uint32_t address, uint32_t coarse_delay, uin
 
 //-----------------------------------------------------------------------------
 void
+PDIMasterNode::apply_endpoint_delays(const std::vector<ActiveEndpointConfig>& ept_configs) const {
+    getNode<VLCmdGeneratorNode>("master.acmd").apply_endpoint_delays(ept_configs);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<uint64_t>
 PDIMasterNode::send_fl_cmd(uint32_t command, uint32_t channel, uint32_t number_of_commands) const {
-    for (uint32_t i=0; i < number_of_commands; i++) {
-        getNode<FLCmdGeneratorNode>("master.scmd_gen").send_fl_cmd(command, channel, getNode<TimestampGeneratorNode>("master.tstamp"));
-    }
+    return getNode<FLCmdGeneratorNode>("master.scmd_gen").send_fl_cmd(command, channel, getNode<TimestampGeneratorNode>("master.tstamp"), number_of_commands);
 }
 //-----------------------------------------------------------------------------
 
@@ -226,24 +262,88 @@ PDIMasterNode::disable_external_triggers() const {
 //-----------------------------------------------------------------------------
 const PartitionNode&
 PDIMasterNode::get_partition_node(uint32_t partition_id) const {
-    const std::string nodeName = "master.partition" + std::to_string(partition_id);
-    return getNode<PartitionNode>(nodeName);
+    const std::vector<std::string>& lNames = get_partition_node_names();
+    if (partition_id < lNames.size()) {
+        return getNode<PartitionNode>(lNames[partition_id]);
+    }
+    // Let uhal report the missing node
+    return getNode<PartitionNode>("master.partition" + std::to_string(partition_id));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<const PartitionNode*>
+PDIMasterNode::get_partition_nodes(const std::vector<uint32_t>& partition_ids) const {
+    std::vector<const PartitionNode*> lPartitions;
+    for (auto lId : partition_ids) {
+        lPartitions.push_back(&get_partition_node(lId));
+    }
+    return lPartitions;
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
 void
-PDIMasterNode::sync_timestamp() const {
+PDIMasterNode::configure_partitions(const std::vector<uint32_t>& partition_ids, uint32_t trigger_mask, bool enable_spill_gate, bool rate_control_enabled) const {
+    for (auto lPartition : get_partition_nodes(partition_ids)) {
+        lPartition->configure(trigger_mask, enable_spill_gate, rate_control_enabled, false);
+        lPartition->enable(true, false);
+    }
+    counted_dispatch(getClient());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::chrono::microseconds
+PDIMasterNode::start_partitions(const std::vector<uint32_t>& partition_ids, uint32_t timeout) const {
+    auto lPartitions = get_partition_nodes(partition_ids);
+
+    for (auto lPartition : lPartitions) {
+        lPartition->request_run_state(true, false);
+    }
+    counted_dispatch(getClient());
+
+    auto lLatency = PartitionNode::wait_for_run_state(lPartitions, true, timeout);
+    TLOG_DEBUG(0) << "Partitions " << vec_fmt(partition_ids) << " started in " << lLatency.count() << " us";
+    return lLatency;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::chrono::microseconds
+PDIMasterNode::stop_partitions(const std::vector<uint32_t>& partition_ids, uint32_t timeout) const {
+    auto lPartitions = get_partition_nodes(partition_ids);
+
+    for (auto lPartition : lPartitions) {
+        lPartition->request_run_state(false, false);
+    }
+    counted_dispatch(getClient());
+
+    auto lLatency = PartitionNode::wait_for_run_state(lPartitions, false, timeout);
+    TLOG_DEBUG(0) << "Partitions " << vec_fmt(partition_ids) << " stopped in " << lLatency.count() << " us";
+    return lLatency;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TimestampOffset
+PDIMasterNode::sync_timestamp(uint32_t samples) const {
+    DispatchScope lDispatchScope("PDIMasterNode::sync_timestamp");
 
     const uint64_t lOldTimestamp = read_timestamp();
     TLOG() << "Old timestamp: " << format_reg_value(lOldTimestamp) << ", " << format_timestamp(lOldTimestamp);
     
-    const uint64_t lNow = get_seconds_since_epoch() * g_dune_sp_clock_in_hz;
-    set_timestamp(lNow);
+    TimestampOffset lOffset = getNode<TimestampGeneratorNode>("master.tstamp").set_timestamp_from_host(samples);
 
     const uint64_t lNewTimestamp = read_timestamp();
     TLOG() << "New timestamp: " << format_reg_value(lNewTimestamp) << ", " << format_timestamp(lNewTimestamp);
+    TLOG() << "Offset from host clock: " << lOffset.offset << " +/- " << lOffset.uncertainty << " ticks (shortest round trip " << lOffset.round_trip.count() << " ns over " << lOffset.samples << " reads)";
+    return lOffset;
 }
 //-----------------------------------------------------------------------------
 
@@ -255,14 +355,14 @@ PDIMasterNode::get_info(timingfirmwareinfo::TimingPDIMasterMonitorData& mon_data
 
     auto spill_interface_enabled = getNode("master.spill.csr.ctrl.en").read();
     auto trig_interface_enabled = getNode("trig.csr.ctrl.ep_en").read();
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     mon_data.spill_interface_enabled = spill_interface_enabled.value();
     mon_data.trig_interface_enabled = trig_interface_enabled.value();
 
     getNode<FLCmdGeneratorNode>("master.scmd_gen").get_info(mon_data.command_counters);
 
-    for (uint i=0; i < 4; ++i) {
+    for (uint i=0; i < kNumberOfPartitions; ++i) {
         timingfirmwareinfo::TimingPartitionMonitorData partition_data;
         get_partition_node(i).get_info(partition_data);
         mon_data.partitions_data.push_back(partition_data);
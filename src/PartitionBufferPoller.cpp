@@ -0,0 +1,134 @@
+#include "timing/PartitionBufferPoller.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace dunedaq {
+namespace timing {
+
+//-----------------------------------------------------------------------------
+PartitionBufferPoller::PartitionBufferPoller(const PartitionNode& partition, std::chrono::microseconds min_interval, std::chrono::microseconds max_interval, double target_occupancy) :
+    m_partition(partition),
+    m_min_interval(min_interval),
+    m_max_interval(std::max(min_interval, max_interval)),
+    m_target_occupancy(target_occupancy),
+    m_capacity(partition.get_buffer_capacity()),
+    m_read_size(partition.get_buffer_read_size()),
+    m_interval(m_max_interval),
+    m_words_left(0),
+    m_first_poll(true),
+    m_stats() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+PartitionBufferPoller::~PartitionBufferPoller() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uhal::ValVector<uint32_t>
+PartitionBufferPoller::poll() {
+
+    PartitionBufferStatus lStatus = m_partition.read_buffer_status();
+    auto lNow = std::chrono::steady_clock::now();
+
+    // Only complete events, and never more than the data port can deliver in one block
+    uint32_t lWordsToRead = lStatus.word_count - (lStatus.word_count % PartitionNode::kWordsPerEvent);
+    if (m_read_size) lWordsToRead = std::min(lWordsToRead, m_read_size - (m_read_size % PartitionNode::kWordsPerEvent));
+
+    uhal::ValVector<uint32_t> lEvents = m_partition.read_buffer_data(lWordsToRead);
+
+    update_interval(lStatus.word_count, lStatus, lNow);
+    m_words_left = lStatus.word_count - lWordsToRead;
+    m_stats.events_read += lWordsToRead / PartitionNode::kWordsPerEvent;
+
+    TLOG_DEBUG(1) << m_partition.getId() << " words: " << lStatus.word_count << ", warn: " << lStatus.warning << ", next poll in " << m_interval.count() << " us";
+
+    return lEvents;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uhal::ValVector<uint32_t>
+PartitionBufferPoller::wait_and_poll() {
+    std::this_thread::sleep_for(m_interval);
+    return poll();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::chrono::microseconds
+PartitionBufferPoller::get_poll_interval() const {
+    return m_interval;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+const PartitionBufferPollerStats&
+PartitionBufferPoller::get_stats() const {
+    return m_stats;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+PartitionBufferPoller::reset_stats() {
+    m_stats = PartitionBufferPollerStats();
+    m_interval = m_max_interval;
+    m_first_poll = true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+PartitionBufferPoller::update_interval(uint32_t words_before_drain, const PartitionBufferStatus& status, std::chrono::steady_clock::time_point now) {
+
+    ++m_stats.polls;
+    if (status.warning) ++m_stats.warnings_seen;
+    if (status.error) ++m_stats.errors_seen;
+
+    if (words_before_drain > m_stats.peak_word_count) {
+        m_stats.peak_word_count = words_before_drain;
+        if (m_capacity) m_stats.peak_occupancy = static_cast<double>(words_before_drain) / m_capacity;
+    }
+
+    auto lElapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - m_last_poll);
+    m_last_poll = now;
+
+    if (m_first_poll) {
+        m_first_poll = false;
+        return;
+    }
+
+    if (status.warning || status.error) {
+        m_interval = m_min_interval;
+        return;
+    }
+
+    // Words accumulated since the previous drain
+    uint32_t lGrowth = words_before_drain > m_words_left ? words_before_drain - m_words_left : 0;
+
+    if (!lGrowth || !lElapsed.count()) {
+        m_interval = std::min(m_interval * 2, m_max_interval);
+        return;
+    }
+
+    double lWordsPerUs = static_cast<double>(lGrowth) / lElapsed.count();
+    double lHeadroom = m_target_occupancy * m_capacity;
+
+    // Poll twice per expected fill-up to the target occupancy
+    auto lInterval = std::chrono::microseconds(static_cast<int64_t>(lHeadroom / lWordsPerUs / 2));
+    m_interval = std::max(m_min_interval, std::min(lInterval, m_max_interval));
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
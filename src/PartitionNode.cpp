@@ -1,5 +1,8 @@
 #include "timing/PartitionNode.hpp"
 
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -32,7 +35,7 @@ PartitionNode::enable(bool enable, bool dispatch) const {
     getNode("csr.ctrl.part_en").write(enable);
     
     if ( dispatch )
-        getClient().dispatch();
+        counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -41,18 +44,21 @@ PartitionNode::enable(bool enable, bool dispatch) const {
 // void
 // PartitionNode::writeTriggerMask( uint32_t aMask) const {
 //     getNode("csr.ctrl.trig_mask").write(aMask);
-//     getClient().dispatch();
+//     counted_dispatch(getClient());
 // }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
 void
-PartitionNode::configure( uint32_t trigger_mask, bool enableSpillGate, bool rate_control_enabled) const {
+PartitionNode::configure( uint32_t trigger_mask, bool enableSpillGate, bool rate_control_enabled, bool dispatch) const {
+    DispatchScope lDispatchScope("PartitionNode::configure");
     getNode("csr.ctrl.rate_ctrl_en").write(rate_control_enabled);
     getNode("csr.ctrl.trig_mask").write(trigger_mask);
     getNode("csr.ctrl.spill_gate_en").write(enableSpillGate);
-    getClient().dispatch();
+
+    if ( dispatch )
+        counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -61,7 +67,7 @@ PartitionNode::configure( uint32_t trigger_mask, bool enableSpillGate, bool rate
 void
 PartitionNode::configure_rate_ctrl( bool rate_control_enabled) const {
     getNode("csr.ctrl.rate_ctrl_en").write(rate_control_enabled);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -71,7 +77,7 @@ void
 PartitionNode::enable_triggers( bool enable ) const {
     // Disable the buffer
     getNode("csr.ctrl.trig_en").write(enable);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -80,7 +86,7 @@ PartitionNode::enable_triggers( bool enable ) const {
 uint32_t
 PartitionNode::read_trigger_mask() const {
     uhal::ValWord<uint32_t> lMask = getNode("csr.ctrl.trig_mask").read();
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     return lMask;
 }
@@ -91,7 +97,7 @@ PartitionNode::read_trigger_mask() const {
 uint32_t
 PartitionNode::read_buffer_word_count() const {
     uhal::ValWord<uint32_t> lWords = getNode("buf.count").read();
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     return lWords;
 
@@ -110,7 +116,7 @@ PartitionNode::num_events_in_buffer() const {
 bool
 PartitionNode::read_rob_warning_overflow() const {
     uhal::ValWord<uint32_t> lWord = getNode("csr.stat.buf_warn").read();
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     return lWord.value();
 
@@ -121,7 +127,7 @@ PartitionNode::read_rob_warning_overflow() const {
 bool
 PartitionNode::read_rob_error() const {
     uhal::ValWord<uint32_t> lWord = getNode("csr.stat.buf_err").read();
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     return lWord.value();
 
@@ -129,10 +135,49 @@ PartitionNode::read_rob_error() const {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+PartitionBufferStatus
+PartitionNode::read_buffer_status() const {
+    auto lWords = getNode("buf.count").read();
+    auto lWarning = getNode("csr.stat.buf_warn").read();
+    auto lError = getNode("csr.stat.buf_err").read();
+    counted_dispatch(getClient());
+
+    return {lWords.value(), static_cast<bool>(lWarning.value()), static_cast<bool>(lError.value())};
+}
+//-----------------------------------------------------------------------------
+
 
 //-----------------------------------------------------------------------------
-std::vector<uint32_t>
+uint32_t
+PartitionNode::get_buffer_capacity() const {
+    const uhal::Node& lBuffer = getNode("buf");
+
+    auto lDepth = lBuffer.getParameters().find("depth");
+    if (lDepth != lBuffer.getParameters().end()) {
+        return boost::lexical_cast< timing::stoul<uint32_t> >(lDepth->second);
+    }
+
+    // Without a declared depth, the largest word count the count register can report
+    uint32_t lCountMask = lBuffer.getNode("count").getMask();
+    return lCountMask >> __builtin_ctz(lCountMask);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint32_t
+PartitionNode::get_buffer_read_size() const {
+    return getNode("buf.data").getSize();
+}
+//-----------------------------------------------------------------------------
+
+
+
+//-----------------------------------------------------------------------------
+uhal::ValVector< uint32_t >
 PartitionNode::read_events( size_t number_of_events ) const {
+    DispatchScope lDispatchScope("PartitionNode::read_events");
 
     uint32_t lEventsInBuffer = num_events_in_buffer();
 
@@ -143,9 +188,24 @@ PartitionNode::read_events( size_t number_of_events ) const {
     }  
 
     uhal::ValVector<uint32_t> lRawEvents = getNode("buf.data").readBlock(lEventsToRead * kWordsPerEvent);
-    getClient().dispatch();
+    counted_dispatch(getClient());
+
+    return lRawEvents;
+}
+//-----------------------------------------------------------------------------
+
 
-    return lRawEvents.value();
+//-----------------------------------------------------------------------------
+uhal::ValVector< uint32_t >
+PartitionNode::read_buffer_data( uint32_t number_of_words ) const {
+
+    // Nothing to dispatch for
+    if (!number_of_words) return uhal::ValVector<uint32_t>(std::vector<uint32_t>());
+
+    uhal::ValVector<uint32_t> lWords = getNode("buf.data").readBlock(number_of_words);
+    counted_dispatch(getClient());
+
+    return lWords;
 }
 //-----------------------------------------------------------------------------
 
@@ -162,69 +222,80 @@ PartitionNode::reset() const {
     getNode("csr.ctrl.trig_ctr_rst").write(1);
     // Release trigger counter
     getNode("csr.ctrl.trig_ctr_rst").write(0);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-void
+std::chrono::microseconds
 PartitionNode::start( uint32_t timeout /*milliseconds*/ ) const {
+    DispatchScope lDispatchScope("PartitionNode::start");
 
-    // Disable triggers (just in case)
-    getNode("csr.ctrl.trig_en").write(0);
-    // Disable the buffer
-    getNode("csr.ctrl.buf_en").write(0);
-    getClient().dispatch();
-    // Re-enable the buffer (flushes it)
-    getNode("csr.ctrl.buf_en").write(1);
-    getClient().dispatch();
-    
-    // Set the run bit and wait for it to be acknowledged
-    getNode("csr.ctrl.run_req").write(1);
-    getClient().dispatch();
-
+    request_run_state(true);
 
-    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    // and wait for it to be acknowledged
+    auto lLatency = wait_for_run_state({this}, true, timeout);
+    TLOG_DEBUG(0) << getId() << " run started in " << lLatency.count() << " us";
+    return lLatency;
+}
+//-----------------------------------------------------------------------------
 
-    while(true) {
-        auto lInRun = getNode("csr.stat.in_run").read();
-        getClient().dispatch();
 
-        if ( lInRun ) break;
+//-----------------------------------------------------------------------------
+std::chrono::microseconds
+PartitionNode::stop( uint32_t timeout /*milliseconds*/ ) const {
+    DispatchScope lDispatchScope("PartitionNode::stop");
 
-        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-        if ( (end - start) > std::chrono::milliseconds(timeout) ) {
-            throw RunRequestTimeoutExpired(ERS_HERE, timeout);
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
+    request_run_state(false);
 
+    auto lLatency = wait_for_run_state({this}, false, timeout);
+    TLOG_DEBUG(0) << getId() << " run stopped in " << lLatency.count() << " us";
+    return lLatency;
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
 void
-PartitionNode::stop( uint32_t timeout /*milliseconds*/ ) const {
-    getNode("csr.ctrl.run_req").write(0);
-    getClient().dispatch();
+PartitionNode::request_run_state( bool in_run, bool dispatch ) const {
+
+    if ( in_run ) {
+        // Disable triggers (just in case)
+        getNode("csr.ctrl.trig_en").write(0);
+        // Disable the buffer
+        getNode("csr.ctrl.buf_en").write(0);
+        // Re-enable the buffer (flushes it)
+        getNode("csr.ctrl.buf_en").write(1);
+    }
+    // Set or clear the run bit. Transactions in a packet are executed in order
+    getNode("csr.ctrl.run_req").write(in_run);
 
-    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if ( dispatch )
+        counted_dispatch(getClient());
+}
+//-----------------------------------------------------------------------------
 
-    while(true) {
 
-        auto lInRun = getNode("csr.stat.in_run").read();
-        getClient().dispatch();
+//-----------------------------------------------------------------------------
+std::chrono::microseconds
+PartitionNode::wait_for_run_state( const std::vector<const PartitionNode*>& partitions, bool in_run, uint32_t timeout /*milliseconds*/ ) {
 
-        if ( !lInRun ) break;
+    if ( partitions.empty() ) return std::chrono::microseconds(0);
 
-        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-        if ( (end - start) > std::chrono::milliseconds(timeout) ) {
-            throw RunRequestTimeoutExpired(ERS_HERE, timeout);
+    auto lResult = poll_until([&partitions, in_run]() {
+        std::vector<uhal::ValWord<uint32_t>> lInRun;
+        for ( auto lPartition : partitions ) {
+            lInRun.push_back(lPartition->getNode("csr.stat.in_run").read());
         }
+        counted_dispatch(partitions.front()->getClient());
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return std::all_of(lInRun.begin(), lInRun.end(), [in_run](const uhal::ValWord<uint32_t>& v) { return static_cast<bool>(v.value()) == in_run; });
+    }, std::chrono::milliseconds(timeout));
+
+    if ( !lResult.success ) {
+        throw RunRequestTimeoutExpired(ERS_HERE, timeout);
     }
+    return lResult.elapsed;
 }
 //-----------------------------------------------------------------------------
 
@@ -238,7 +309,7 @@ PartitionNode::read_command_counts() const {
     
     uhal::ValVector<uint32_t> lAccepted = lAccCtrs.readBlock(lAccCtrs.getSize());
     uhal::ValVector<uint32_t> lRejected = lRejCtrs.readBlock(lRejCtrs.getSize());
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     return {lAccepted.value(), lRejected.value()};
 
@@ -249,6 +320,7 @@ PartitionNode::read_command_counts() const {
 //-----------------------------------------------------------------------------
 std::string
 PartitionNode::get_status(bool print_out) const {
+    DispatchScope lDispatchScope("PartitionNode::get_status");
     std::stringstream lStatus;
 
     auto lControls = read_sub_nodes(getNode("csr.ctrl"), false);
@@ -260,7 +332,7 @@ PartitionNode::get_status(bool print_out) const {
     auto lAccCounters = getNode("actrs").readBlock(getNode("actrs").getSize());
     auto lRejCounters = getNode("rctrs").readBlock(getNode("actrs").getSize());
     
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     std::string lPartID = getId();
     std::string lPartNum = lPartID.substr(lPartID.find("partition") + 9) ;
@@ -286,6 +358,50 @@ PartitionNode::get_status(bool print_out) const {
     return lStatus.str();
 }
 //-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+PartitionNode::report_status(StatusSink& sink) const {
+    DispatchScope lDispatchScope("PartitionNode::report_status");
+
+    auto lControls = read_sub_nodes(getNode("csr.ctrl"), false);
+    auto lState = read_sub_nodes(getNode("csr.stat"), false);
+
+    auto lEventCtr = getNode("evtctr").read();
+    auto lBufCount = getNode("buf.count").read();
+
+    auto lAccCounters = getNode("actrs").readBlock(getNode("actrs").getSize());
+    auto lRejCounters = getNode("rctrs").readBlock(getNode("rctrs").getSize());
+
+    counted_dispatch(getClient());
+
+    std::vector<std::string> lCommandLabels;
+    for (uint32_t i=0; i < lAccCounters.size(); ++i) {
+        auto lCommand = g_command_map.find(i);
+        lCommandLabels.push_back(lCommand != g_command_map.end() ? lCommand->second : std::to_string(i));
+    }
+
+    sink.begin_section(getId());
+
+    sink.begin_section("Controls");
+    sink.add_registers(lControls);
+    sink.end_section();
+
+    sink.begin_section("State");
+    sink.add_registers(lState);
+    sink.end_section();
+
+    sink.add_register("Event counter", lEventCtr.value());
+    sink.add_flag("Buffer error", lState.find("buf_err")->second.value());
+    sink.add_register("Buffer occupancy", lBufCount.value());
+
+    sink.add_counters("Accept counters", lCommandLabels, lAccCounters.value());
+    sink.add_counters("Reject counters", lCommandLabels, lRejCounters.value());
+
+    sink.end_section();
+}
+//-----------------------------------------------------------------------------
 void
 PartitionNode::get_info(timingfirmwareinfo::TimingPartitionMonitorData& mon_data) const {
     auto lControls = read_sub_nodes(getNode("csr.ctrl"), false);
@@ -297,7 +413,7 @@ PartitionNode::get_info(timingfirmwareinfo::TimingPartitionMonitorData& mon_data
     //auto lAccCounters = getNode("actrs").readBlock(getNode("actrs").getSize());
     //auto lRejCounters = getNode("rctrs").readBlock(getNode("actrs").getSize());
     
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     mon_data.enabled = lControls.at("part_en").value();
     mon_data.spill_interface_enabled = lControls.at("spill_gate_en").value();
@@ -161,6 +161,7 @@ SI534xSlave::read_config_section( std::ifstream& file, std::string tag ) const {
 //-----------------------------------------------------------------------------
 void
 SI534xSlave::configure( const std::string& aPath ) const {
+    DispatchScope lDispatchScope("SI534xSlave::configure");
 
     throw_if_not_file(aPath);
 
@@ -350,6 +351,36 @@ SI534xSlave::get_info(timinghardwareinfo::TimingPLLMonitorData& mon_data) const
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+void
+SI534xSlave::report_status(StatusSink& sink) const {
+    timinghardwareinfo::TimingPLLMonitorData lPLLInfo;
+    get_info(lPLLInfo);
+
+    sink.begin_section("PLL status");
+    sink.add_text("Config ID", lPLLInfo.config_id);
+    sink.add_register("Device version", read_device_version());
+    sink.add_register("Device grade", read_clock_register(0x4));
+    sink.add_register("Device revision", read_clock_register(0x5));
+    sink.add_flag("cal_pll", lPLLInfo.cal_pll);
+    sink.add_flag("hold", lPLLInfo.hold);
+    sink.add_flag("lol", lPLLInfo.lol);
+    sink.add_register("los", lPLLInfo.los);
+    sink.add_flag("los_xaxb", lPLLInfo.los_xaxb);
+    sink.add_flag("los_xaxb_flg", lPLLInfo.los_xaxb_flg);
+    sink.add_register("oof", lPLLInfo.oof);
+    sink.add_register("oof_sticky", lPLLInfo.oof_sticky);
+    sink.add_flag("smbus_timeout", lPLLInfo.smbus_timeout);
+    sink.add_flag("smbus_timeout_flg", lPLLInfo.smbus_timeout_flg);
+    sink.add_flag("sys_in_cal", lPLLInfo.sys_in_cal);
+    sink.add_flag("sys_in_cal_flg", lPLLInfo.sys_in_cal_flg);
+    sink.add_flag("xaxb_err", lPLLInfo.xaxb_err);
+    sink.add_flag("xaxb_err_flg", lPLLInfo.xaxb_err_flg);
+    sink.end_section();
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 SI534xNode::SI534xNode( const uhal::Node& node ) : I2CMasterNode(node), SI534xSlave(this, this->get_slave_address("i2caddr") ) {
 }
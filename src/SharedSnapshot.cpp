@@ -0,0 +1,270 @@
+#include "timing/SharedSnapshot.hpp"
+
+#include "timing/toolbox.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dunedaq {
+namespace timing {
+
+namespace {
+
+int64_t to_ns(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point from_ns(int64_t ns) {
+    return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns)));
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+SharedSnapshotWriter::SharedSnapshotWriter(const std::string& name, uint32_t number_of_slots, uint32_t slot_capacity) :
+    m_name(name),
+    m_size(0),
+    m_segment(nullptr),
+    m_header(nullptr) {
+
+    const size_t lHeaderSize = (sizeof(shared_snapshot::Header) + shared_snapshot::kAlignment - 1) / shared_snapshot::kAlignment * shared_snapshot::kAlignment;
+    const size_t lSlotStride = (sizeof(shared_snapshot::Slot) + slot_capacity + shared_snapshot::kAlignment - 1) / shared_snapshot::kAlignment * shared_snapshot::kAlignment;
+    m_size = lHeaderSize + lSlotStride * number_of_slots;
+
+    // Start from a fresh segment: readers of a previous one keep their own mapping
+    ::shm_unlink(m_name.c_str());
+
+    int lFd = ::shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (lFd < 0) throw SharedMemoryError(ERS_HERE, m_name, strerror(errno));
+
+    if (::ftruncate(lFd, m_size) < 0) {
+        std::string lReason = strerror(errno);
+        ::close(lFd);
+        throw SharedMemoryError(ERS_HERE, m_name, lReason);
+    }
+
+    m_segment = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, lFd, 0);
+    ::close(lFd);
+    if (m_segment == MAP_FAILED) throw SharedMemoryError(ERS_HERE, m_name, strerror(errno));
+
+    // The segment comes zero-filled: all sequences start even and no slot is used
+    m_header = new (m_segment) shared_snapshot::Header;
+    m_header->layout_version = shared_snapshot::kLayoutVersion;
+    m_header->number_of_slots = number_of_slots;
+    m_header->slot_capacity = slot_capacity;
+    m_header->slot_stride = lSlotStride;
+    m_header->slots_offset = lHeaderSize;
+    m_header->slots_used.store(0, std::memory_order_relaxed);
+    m_header->magic.store(shared_snapshot::kMagic, std::memory_order_release);
+
+    TLOG_DEBUG(0) << "Shared snapshot segment " << m_name << " created: " << number_of_slots << " slots of " << slot_capacity << " bytes";
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+SharedSnapshotWriter::~SharedSnapshotWriter() {
+    ::munmap(m_segment, m_size);
+    ::shm_unlink(m_name.c_str());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SharedSnapshotWriter::publish(const std::string& record, const std::string& payload, std::chrono::system_clock::time_point time_gathered) {
+
+    if (payload.size() > m_header->slot_capacity) {
+        throw SharedSnapshotTooLarge(ERS_HERE, record, payload.size(), m_header->slot_capacity);
+    }
+
+    auto lIndex = m_slot_indices.find(record);
+    bool lNewSlot = lIndex == m_slot_indices.end();
+    if (lNewSlot) {
+        uint32_t lUsed = m_header->slots_used.load(std::memory_order_relaxed);
+        if (lUsed >= m_header->number_of_slots || record.size() >= shared_snapshot::kMaxNameLength) {
+            throw SharedMemoryError(ERS_HERE, m_name, "no slot available for record " + record);
+        }
+        lIndex = m_slot_indices.emplace(record, lUsed).first;
+    }
+
+    shared_snapshot::Slot& lSlot = get_slot(lIndex->second);
+
+    uint64_t lSequence = lSlot.sequence.load(std::memory_order_relaxed);
+    lSlot.sequence.store(lSequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (lNewSlot) std::strncpy(lSlot.name, record.c_str(), shared_snapshot::kMaxNameLength - 1);
+    lSlot.time_gathered = to_ns(time_gathered);
+    lSlot.time_published = to_ns(std::chrono::system_clock::now());
+    ++lSlot.version;
+    lSlot.size = payload.size();
+    std::memcpy(reinterpret_cast<char*>(&lSlot) + sizeof(shared_snapshot::Slot), payload.data(), payload.size());
+
+    lSlot.sequence.store(lSequence + 2, std::memory_order_release);
+
+    // Readers only look at slots below slots_used, so a new slot is complete before it shows up
+    if (lNewSlot) m_header->slots_used.store(lIndex->second + 1, std::memory_order_release);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+shared_snapshot::Slot&
+SharedSnapshotWriter::get_slot(uint32_t index) const {
+    char* lBase = static_cast<char*>(m_segment) + m_header->slots_offset;
+    return *reinterpret_cast<shared_snapshot::Slot*>(lBase + static_cast<size_t>(m_header->slot_stride) * index);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+SharedSnapshotReader::SharedSnapshotReader(const std::string& name) :
+    m_name(name),
+    m_size(0),
+    m_segment(nullptr),
+    m_header(nullptr) {
+
+    int lFd = ::shm_open(m_name.c_str(), O_RDONLY, 0);
+    if (lFd < 0) throw SharedMemoryError(ERS_HERE, m_name, strerror(errno));
+
+    struct stat lStat;
+    if (::fstat(lFd, &lStat) < 0) {
+        std::string lReason = strerror(errno);
+        ::close(lFd);
+        throw SharedMemoryError(ERS_HERE, m_name, lReason);
+    }
+    m_size = lStat.st_size;
+
+    m_segment = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, lFd, 0);
+    ::close(lFd);
+    if (m_segment == MAP_FAILED) throw SharedMemoryError(ERS_HERE, m_name, strerror(errno));
+
+    m_header = static_cast<const shared_snapshot::Header*>(m_segment);
+    if (m_size < sizeof(shared_snapshot::Header)
+            || m_header->magic.load(std::memory_order_acquire) != shared_snapshot::kMagic
+            || m_header->layout_version != shared_snapshot::kLayoutVersion
+            || m_size < m_header->slots_offset + static_cast<size_t>(m_header->slot_stride) * m_header->number_of_slots) {
+        ::munmap(m_segment, m_size);
+        throw SharedMemoryError(ERS_HERE, m_name, "not an initialised snapshot segment");
+    }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+SharedSnapshotReader::~SharedSnapshotReader() {
+    ::munmap(m_segment, m_size);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+SharedSnapshot
+SharedSnapshotReader::read(const std::string& record) {
+    auto lIndex = m_slot_indices.find(record);
+    if (lIndex == m_slot_indices.end()) {
+        refresh_slot_indices();
+        lIndex = m_slot_indices.find(record);
+        if (lIndex == m_slot_indices.end()) throw SharedSnapshotNotFound(ERS_HERE, m_name, record);
+    }
+    return read_slot(lIndex->second);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<SharedSnapshot>
+SharedSnapshotReader::read_all() {
+    uint32_t lUsed = m_header->slots_used.load(std::memory_order_acquire);
+
+    std::vector<SharedSnapshot> lSnapshots;
+    for (uint32_t i=0; i < lUsed; ++i) lSnapshots.push_back(read_slot(i));
+    return lSnapshots;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<std::string>
+SharedSnapshotReader::get_record_names() {
+    refresh_slot_indices();
+
+    std::vector<std::string> lNames(m_slot_indices.size());
+    for (auto& lIndex : m_slot_indices) lNames.at(lIndex.second) = lIndex.first;
+    return lNames;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SharedSnapshotReader::refresh_slot_indices() {
+    uint32_t lUsed = m_header->slots_used.load(std::memory_order_acquire);
+
+    // Names never change once a slot is in use
+    for (uint32_t i=m_slot_indices.size(); i < lUsed; ++i) {
+        const shared_snapshot::Slot& lSlot = get_slot(i);
+        m_slot_indices.emplace(std::string(lSlot.name, strnlen(lSlot.name, shared_snapshot::kMaxNameLength)), i);
+    }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+SharedSnapshot
+SharedSnapshotReader::read_slot(uint32_t index) const {
+    const shared_snapshot::Slot& lSlot = get_slot(index);
+    const char* lPayload = reinterpret_cast<const char*>(&lSlot) + sizeof(shared_snapshot::Slot);
+
+    SharedSnapshot lSnapshot;
+    lSnapshot.name.assign(lSlot.name, strnlen(lSlot.name, shared_snapshot::kMaxNameLength));
+    lSnapshot.payload.reserve(m_header->slot_capacity);
+
+    std::chrono::steady_clock::time_point lDeadline;
+    for (uint32_t lAttempt=0;; ++lAttempt) {
+        uint64_t lBefore = lSlot.sequence.load(std::memory_order_acquire);
+
+        if (!(lBefore & 1)) {
+            uint32_t lSize = std::min(lSlot.size, m_header->slot_capacity);
+            lSnapshot.payload.assign(lPayload, lSize);
+            lSnapshot.time_gathered = from_ns(lSlot.time_gathered);
+            lSnapshot.time_published = from_ns(lSlot.time_published);
+            lSnapshot.version = lSlot.version;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (lSlot.sequence.load(std::memory_order_relaxed) == lBefore) return lSnapshot;
+        }
+
+        // The writer holds a slot for the duration of one copy; only yield if it got descheduled,
+        // and give up if it does not come back, e.g. if it died in the middle of a copy
+        if (lAttempt < 64) continue;
+        if (lAttempt == 64) {
+            lDeadline = std::chrono::steady_clock::now() + shared_snapshot::kMaxReadTime;
+        } else if (std::chrono::steady_clock::now() > lDeadline) {
+            throw SharedSnapshotReadTimeout(ERS_HERE, m_name, lSnapshot.name, shared_snapshot::kMaxReadTime.count());
+        }
+        std::this_thread::yield();
+    }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+const shared_snapshot::Slot&
+SharedSnapshotReader::get_slot(uint32_t index) const {
+    const char* lBase = static_cast<const char*>(m_segment) + m_header->slots_offset;
+    return *reinterpret_cast<const shared_snapshot::Slot*>(lBase + static_cast<size_t>(m_header->slot_stride) * index);
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
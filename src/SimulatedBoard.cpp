@@ -0,0 +1,707 @@
+#include "timing/SimulatedBoard.hpp"
+
+#include "timing/PartitionNode.hpp"
+#include "timing/definitions.hpp"
+#include "timing/toolbox.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+
+namespace dunedaq {
+namespace timing {
+
+namespace {
+
+const uint32_t kEventHeader = 0xaa000600;
+const uint32_t kNumberOfCounters = 0x10;
+const uint32_t kNumberOfGenerators = 5;
+
+// OpenCores I2C master command and status bits
+const uint32_t kI2CStartCmd = 0x80;
+const uint32_t kI2CStopCmd = 0x40;
+const uint32_t kI2CReadCmd = 0x20;
+const uint32_t kI2CWriteCmd = 0x10;
+const uint32_t kI2CNoAckBit = 0x80;
+const uint32_t kI2CBusyBit = 0x40;
+
+uint32_t
+pack(uint32_t mask, uint32_t value) {
+    return mask ? (value << __builtin_ctz(mask)) & mask : 0x0;
+}
+
+uint32_t
+unpack(uint32_t mask, uint32_t word) {
+    return mask ? (word & mask) >> __builtin_ctz(mask) : 0x0;
+}
+
+std::vector<std::string>
+get_sorted_nodes(const uhal::Node& node, const std::string& regex) {
+    std::vector<std::string> lNodes = node.getNodes(regex);
+    std::sort(lNodes.begin(), lNodes.end());
+    return lNodes;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+SimulatedBoard::SimulatedBoard(const uhal::Node& top, const SimulatedBoardConfig& config) :
+    m_config(config),
+    m_random(config.seed),
+    m_epoch(std::chrono::steady_clock::now()),
+    m_epoch_timestamp(0),
+    m_now(m_epoch),
+    m_commands(0),
+    m_acmd_done(0) {
+
+    build_io(top.getNode("io"));
+    build_master(top.getNode("master_top"));
+    for (auto& lEndpoint : get_sorted_nodes(top, "endpoint[0-9]+")) build_endpoint(top.getNode(lEndpoint));
+
+    reset_state();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+SimulatedBoard::~SimulatedBoard() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint32_t
+SimulatedBoard::read(uint32_t address) {
+    std::lock_guard<std::mutex> lLock(m_mutex);
+    update();
+
+    auto lReader = m_readers.find(address);
+    if (lReader != m_readers.end()) return lReader->second();
+
+    auto lRegister = m_registers.find(address);
+    return lRegister != m_registers.end() ? lRegister->second : 0x0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::write(uint32_t address, uint32_t value) {
+    std::lock_guard<std::mutex> lLock(m_mutex);
+    update();
+
+    uint32_t lPrevious = m_registers[address];
+    m_registers[address] = value;
+
+    auto lWriter = m_writers.find(address);
+    if (lWriter != m_writers.end()) lWriter->second(lPrevious);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::enable_fake_trigger(uint32_t channel, uint32_t divisor, uint32_t prescale, bool poisson) {
+    std::lock_guard<std::mutex> lLock(m_mutex);
+    update();
+
+    Generator& lGenerator = m_generators.at(channel);
+    lGenerator.ctrl = pack(m_gen_masks.en, 0x1) | pack(m_gen_masks.patt, poisson) | pack(m_gen_masks.type, 0x8 + channel)
+                    | pack(m_gen_masks.rate_div_p, prescale) | pack(m_gen_masks.rate_div_d, divisor);
+    lGenerator.next = get_tick(m_now) + get_interval(lGenerator);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::advance() {
+    std::lock_guard<std::mutex> lLock(m_mutex);
+    update();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint64_t
+SimulatedBoard::read_timestamp() {
+    std::lock_guard<std::mutex> lLock(m_mutex);
+    update();
+    return get_tick(m_now);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint64_t
+SimulatedBoard::get_command_count() const {
+    std::lock_guard<std::mutex> lLock(m_mutex);
+    return m_commands;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+SimulatedBoard::Field
+SimulatedBoard::resolve(const uhal::Node& node) const {
+    return {node.getAddress(), node.getMask()};
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint32_t
+SimulatedBoard::get_field(const Field& field) const {
+    auto lRegister = m_registers.find(field.address);
+    return lRegister != m_registers.end() ? unpack(field.mask, lRegister->second) : 0x0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::set_field(const Field& field, uint32_t value) {
+    uint32_t& lRegister = m_registers[field.address];
+    lRegister = (lRegister & ~field.mask) | pack(field.mask, value);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::on_read(const uhal::Node& node, std::function<uint32_t()> reader) {
+    m_readers[node.getAddress()] = reader;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::on_write(const uhal::Node& node, std::function<void(uint32_t)> writer) {
+    m_writers[node.getAddress()] = writer;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::on_block_read(const uhal::Node& node, std::function<uint32_t(uint32_t)> reader) {
+    for (uint32_t i=0; i < node.getSize(); ++i) {
+        m_readers[node.getAddress() + i] = [reader, i]() { return reader(i); };
+    }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::build_io(const uhal::Node& io) {
+    uint32_t lConfig = pack(io.getNode("config.board_type").getMask(), kBoardSim)
+                     | pack(io.getNode("config.carrier_type").getMask(), kCarrierEnclustraA35)
+                     | pack(io.getNode("config.design_type").getMask(), kDesignOuroborosSim);
+    on_read(io.getNode("config"), [lConfig]() { return lConfig; });
+
+    uint32_t lLocked = io.getNode("csr.stat.locked").getMask();
+    on_read(io.getNode("csr.stat"), [lLocked]() { return lLocked; });
+
+    // The soft reset bit clears itself, and with it the state of the design
+    Field lSoftReset = resolve(io.getNode("csr.ctrl.soft_rst"));
+    on_write(io.getNode("csr.ctrl"), [this, lSoftReset](uint32_t) {
+        if (get_field(lSoftReset)) reset_state();
+    });
+
+    for (auto& lI2C : io.getNodes("[a-z_]+_i2c")) build_i2c(io.getNode(lI2C));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::build_i2c(const uhal::Node& i2c) {
+    uint32_t lIndex = m_i2c_buses.size();
+    m_i2c_buses.push_back({0x0, 0x0, {}, nullptr, false, false});
+
+    for (auto& lParameter : i2c.getParameters()) {
+        uint8_t lAddress = boost::lexical_cast< timing::stoul<uint32_t> >(lParameter.second) & 0x7f;
+        m_i2c_buses.back().slaves[lAddress] = {0x0, 0x0, {}};
+    }
+
+    // tx and rx share the data register: writes are stored, reads return the last byte received
+    uint32_t lTx = i2c.getNode("data").getAddress();
+    uint32_t lCmd = i2c.getNode("cmd_stat").getAddress();
+    on_read(i2c.getNode("data"), [this, lIndex]() { return m_i2c_buses.at(lIndex).rx; });
+    on_read(i2c.getNode("cmd_stat"), [this, lIndex]() { return m_i2c_buses.at(lIndex).status; });
+    on_write(i2c.getNode("cmd_stat"), [this, lIndex, lTx, lCmd](uint32_t) {
+        execute_i2c(m_i2c_buses.at(lIndex), m_registers[lCmd], m_registers[lTx]);
+    });
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::execute_i2c(I2CBus& bus, uint32_t command, uint32_t data) {
+    if (command & kI2CStartCmd) {
+        // Address byte: unknown slaves do not acknowledge
+        auto lSlave = bus.slaves.find((data >> 1) & 0x7f);
+        bus.selected = (lSlave != bus.slaves.end()) ? &lSlave->second : nullptr;
+        bus.reading = data & 0x1;
+        bus.pointer_pending = !bus.reading;
+        bus.status = kI2CBusyBit | (bus.selected ? 0x0 : kI2CNoAckBit);
+    } else if (command & kI2CWriteCmd) {
+        if (bus.selected && !bus.reading) {
+            I2CSlave& lSlave = *bus.selected;
+            if (bus.pointer_pending) {
+                lSlave.pointer = data;
+                bus.pointer_pending = false;
+            } else {
+                if (lSlave.pointer == 0x1) lSlave.page = data;
+                else lSlave.registers[(lSlave.page << 8) | lSlave.pointer] = data;
+                ++lSlave.pointer;
+            }
+        }
+        bus.status = kI2CBusyBit | (bus.selected && !bus.reading ? 0x0 : kI2CNoAckBit);
+    } else if (command & kI2CReadCmd) {
+        bus.rx = 0xff;
+        if (bus.selected && bus.reading) {
+            I2CSlave& lSlave = *bus.selected;
+            bus.rx = (lSlave.pointer == 0x1) ? lSlave.page : lSlave.registers[(lSlave.page << 8) | lSlave.pointer];
+            ++lSlave.pointer;
+        }
+        bus.status |= kI2CBusyBit;
+    }
+
+    if (command & kI2CStopCmd) {
+        bus.selected = nullptr;
+        bus.status &= ~kI2CBusyBit;
+    }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::build_master(const uhal::Node& master_top) {
+    const uhal::Node& lMaster = master_top.getNode("master");
+
+    // Global
+    const uhal::Node& lGlobal = lMaster.getNode("global");
+    Field lGlobalEpEn = resolve(lGlobal.getNode("csr.ctrl.ep_en"));
+    uint32_t lGlobalEpStat = lGlobal.getNode("csr.stat.ep_stat").getMask();
+    uint32_t lGlobalEpRdy = lGlobal.getNode("csr.stat.ep_rdy").getMask();
+    on_read(lGlobal.getNode("csr.stat"), [this, lGlobalEpEn, lGlobalEpStat, lGlobalEpRdy]() {
+        bool lReady = get_field(lGlobalEpEn);
+        return pack(lGlobalEpStat, lReady ? 0x8 : 0x0) | pack(lGlobalEpRdy, lReady);
+    });
+
+    // Timestamp; the counter is loaded when the high word of ctr.set is written
+    const uhal::Node& lTStamp = lMaster.getNode("tstamp");
+    on_block_read(lTStamp.getNode("ctr.val"), [this](uint32_t i) {
+        uint64_t lTimestamp = get_tick(m_now);
+        return static_cast<uint32_t>(i ? lTimestamp >> 32 : lTimestamp);
+    });
+    uint32_t lTStampSet = lTStamp.getNode("ctr.set").getAddress();
+    m_writers[lTStampSet + 1] = [this, lTStampSet](uint32_t) {
+        m_epoch = m_now;
+        m_epoch_timestamp = (static_cast<uint64_t>(m_registers[lTStampSet + 1]) << 32) | m_registers[lTStampSet];
+        for (auto& lGenerator : m_generators) lGenerator.next = m_epoch_timestamp + get_interval(lGenerator);
+        m_acmd_done = 0;
+    };
+
+    // Async commands; done clears on go and is set again once the command is sent
+    const uhal::Node& lAcmd = lMaster.getNode("acmd");
+    Field lAcmdGo = resolve(lAcmd.getNode("csr.ctrl.go"));
+    uint32_t lAcmdDone = lAcmd.getNode("csr.stat.done").getMask();
+    on_write(lAcmd.getNode("csr.ctrl"), [this, lAcmdGo](uint32_t previous) {
+        if (get_field(lAcmdGo) && !unpack(lAcmdGo.mask, previous)) m_acmd_done = get_tick(m_now) + m_config.acmd_delay;
+    });
+    on_read(lAcmd.getNode("csr.stat"), [this, lAcmdDone]() { return pack(lAcmdDone, get_tick(m_now) >= m_acmd_done); });
+
+    // Echo; the round trip is timed against the timestamp counter
+    const uhal::Node& lEcho = lMaster.getNode("echo");
+    Field lEchoGo = resolve(lEcho.getNode("csr.ctrl.go"));
+    Field lEchoDone = resolve(lEcho.getNode("csr.stat.rx_done"));
+    Field lEchoTxL = resolve(lEcho.getNode("csr.tx_l"));
+    Field lEchoTxH = resolve(lEcho.getNode("csr.tx_h"));
+    Field lEchoRxL = resolve(lEcho.getNode("csr.rx_l"));
+    Field lEchoRxH = resolve(lEcho.getNode("csr.rx_h"));
+    on_write(lEcho.getNode("csr.ctrl"), [=](uint32_t) {
+        if (!get_field(lEchoGo)) return;
+        uint64_t lTx = get_tick(m_now);
+        uint64_t lRx = lTx + m_config.echo_delay;
+        set_field(lEchoTxL, lTx);
+        set_field(lEchoTxH, lTx >> 32);
+        set_field(lEchoRxL, lRx);
+        set_field(lEchoRxH, lRx >> 32);
+        set_field(lEchoDone, 0x1);
+    });
+
+    // Fast command generators; chan_ctrl is banked by sel
+    const uhal::Node& lGen = lMaster.getNode("scmd_gen");
+    m_generators.resize(kNumberOfGenerators);
+    m_gen_accepted.resize(kNumberOfCounters);
+    m_gen_rejected.resize(kNumberOfCounters);
+
+    Field lGenSel = resolve(lGen.getNode("sel"));
+    Field lGenClr = resolve(lGen.getNode("ctrl.clr"));
+    const uhal::Node& lChanCtrl = lGen.getNode("chan_ctrl");
+    uint32_t lChanCtrlAddress = lChanCtrl.getAddress();
+    m_gen_masks = {
+        lChanCtrl.getNode("en").getMask(),
+        lChanCtrl.getNode("patt").getMask(),
+        lChanCtrl.getNode("force").getMask(),
+        lChanCtrl.getNode("type").getMask(),
+        lChanCtrl.getNode("rate_div_p").getMask(),
+        lChanCtrl.getNode("rate_div_d").getMask()
+    };
+
+    on_read(lChanCtrl, [this, lGenSel]() {
+        uint32_t lSel = get_field(lGenSel);
+        return lSel < m_generators.size() ? m_generators.at(lSel).ctrl : 0x0;
+    });
+    on_write(lChanCtrl, [this, lGenSel, lChanCtrlAddress](uint32_t) {
+        uint32_t lSel = get_field(lGenSel);
+        if (lSel >= m_generators.size()) return;
+
+        Generator& lGenerator = m_generators.at(lSel);
+        uint32_t lPrevious = lGenerator.ctrl;
+        lGenerator.ctrl = m_registers[lChanCtrlAddress];
+
+        if ((lGenerator.ctrl & m_gen_masks.en) && !(lPrevious & m_gen_masks.en)) {
+            lGenerator.next = get_tick(m_now) + get_interval(lGenerator);
+        }
+        if ((lGenerator.ctrl & m_gen_masks.force) && !(lPrevious & m_gen_masks.force)) {
+            issue_command(lSel, unpack(m_gen_masks.type, lGenerator.ctrl), get_tick(m_now));
+        }
+    });
+    on_write(lGen.getNode("ctrl"), [this, lGenClr](uint32_t) {
+        if (!get_field(lGenClr)) return;
+        std::fill(m_gen_accepted.begin(), m_gen_accepted.end(), 0);
+        std::fill(m_gen_rejected.begin(), m_gen_rejected.end(), 0);
+    });
+    on_block_read(lGen.getNode("actrs"), [this](uint32_t i) { return i < m_gen_accepted.size() ? m_gen_accepted.at(i) : 0x0; });
+    on_block_read(lGen.getNode("rctrs"), [this](uint32_t i) { return i < m_gen_rejected.size() ? m_gen_rejected.at(i) : 0x0; });
+
+    // Partitions
+    std::vector<std::string> lPartitions = get_sorted_nodes(lMaster, "partition[0-9]+");
+    m_partitions.reserve(lPartitions.size());
+    for (auto& lPartition : lPartitions) build_partition(lMaster.getNode(lPartition));
+
+    uint32_t lGlobalConfig = pack(lGlobal.getNode("config.n_part").getMask(), m_partitions.size())
+                           | pack(lGlobal.getNode("config.n_chan").getMask(), m_generators.size());
+    on_read(lGlobal.getNode("config"), [lGlobalConfig]() { return lGlobalConfig; });
+
+    // Trigger receiver
+    const uhal::Node& lTrig = master_top.getNode("trig");
+    Field lTrigEpEn = resolve(lTrig.getNode("csr.ctrl.ep_en"));
+    uint32_t lTrigEpStat = lTrig.getNode("csr.stat.ep_stat").getMask();
+    uint32_t lTrigEpRdy = lTrig.getNode("csr.stat.ep_rdy").getMask();
+    on_read(lTrig.getNode("csr.stat"), [this, lTrigEpEn, lTrigEpStat, lTrigEpRdy]() {
+        bool lReady = get_field(lTrigEpEn);
+        return pack(lTrigEpStat, lReady ? 0x8 : 0x0) | pack(lTrigEpRdy, lReady);
+    });
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::build_partition(const uhal::Node& partition) {
+    uint32_t lIndex = m_partitions.size();
+    m_partitions.emplace_back();
+    Partition& lPartition = m_partitions.back();
+
+    lPartition.part_en = resolve(partition.getNode("csr.ctrl.part_en"));
+    lPartition.run_req = resolve(partition.getNode("csr.ctrl.run_req"));
+    lPartition.trig_en = resolve(partition.getNode("csr.ctrl.trig_en"));
+    lPartition.buf_en = resolve(partition.getNode("csr.ctrl.buf_en"));
+    lPartition.trig_ctr_rst = resolve(partition.getNode("csr.ctrl.trig_ctr_rst"));
+    lPartition.trig_mask = resolve(partition.getNode("csr.ctrl.trig_mask"));
+
+    // The run state follows the run request after the configured latency
+    on_write(partition.getNode("csr.ctrl"), [this, lIndex](uint32_t) {
+        Partition& lPartition = m_partitions.at(lIndex);
+
+        bool lRunRequest = get_field(lPartition.run_req);
+        if (lRunRequest != lPartition.in_run) {
+            if (!m_config.run_latency.count()) {
+                lPartition.in_run = lRunRequest;
+                lPartition.run_pending = false;
+            } else if (!lPartition.run_pending) {
+                lPartition.run_pending = true;
+                lPartition.run_deadline = m_now + m_config.run_latency;
+            }
+        } else {
+            lPartition.run_pending = false;
+        }
+
+        if (!get_field(lPartition.buf_en)) {
+            lPartition.buffer.clear();
+            lPartition.buffer_error = false;
+        }
+
+        if (get_field(lPartition.trig_ctr_rst)) {
+            std::fill(lPartition.accepted.begin(), lPartition.accepted.end(), 0);
+            std::fill(lPartition.rejected.begin(), lPartition.rejected.end(), 0);
+            lPartition.event_counter = 0;
+        }
+    });
+
+    const uhal::Node& lStat = partition.getNode("csr.stat");
+    uint32_t lBufErr = lStat.getNode("buf_err").getMask();
+    uint32_t lBufWarn = lStat.getNode("buf_warn").getMask();
+    uint32_t lPartUp = lStat.getNode("part_up").getMask();
+    uint32_t lRunInt = lStat.getNode("run_int").getMask();
+    uint32_t lInRun = lStat.getNode("in_run").getMask();
+    on_read(lStat, [=]() {
+        const Partition& lPartition = m_partitions.at(lIndex);
+        return pack(lBufErr, lPartition.buffer_error)
+             | pack(lBufWarn, lPartition.buffer.size() > m_config.buffer_depth / 2)
+             | pack(lPartUp, get_field(lPartition.part_en))
+             | pack(lRunInt, lPartition.in_run)
+             | pack(lInRun, lPartition.in_run);
+    });
+
+    on_read(partition.getNode("evtctr"), [this, lIndex]() { return m_partitions.at(lIndex).event_counter; });
+
+    uint32_t lCountMask = partition.getNode("buf.count").getMask();
+    on_read(partition.getNode("buf.count"), [this, lIndex, lCountMask]() {
+        return pack(lCountMask, m_partitions.at(lIndex).buffer.size());
+    });
+    on_read(partition.getNode("buf.data"), [this, lIndex]() {
+        std::deque<uint32_t>& lBuffer = m_partitions.at(lIndex).buffer;
+        if (lBuffer.empty()) return 0x0u;
+        uint32_t lWord = lBuffer.front();
+        lBuffer.pop_front();
+        return lWord;
+    });
+
+    on_block_read(partition.getNode("actrs"), [this, lIndex](uint32_t i) {
+        const Partition& lPartition = m_partitions.at(lIndex);
+        return i < lPartition.accepted.size() ? lPartition.accepted.at(i) : 0x0;
+    });
+    on_block_read(partition.getNode("rctrs"), [this, lIndex](uint32_t i) {
+        const Partition& lPartition = m_partitions.at(lIndex);
+        return i < lPartition.rejected.size() ? lPartition.rejected.at(i) : 0x0;
+    });
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::build_endpoint(const uhal::Node& endpoint) {
+    uint32_t lIndex = m_endpoints.size();
+    m_endpoints.emplace_back();
+    Endpoint& lEndpoint = m_endpoints.back();
+
+    lEndpoint.ep_en = resolve(endpoint.getNode("csr.ctrl.ep_en"));
+    lEndpoint.buf_en = resolve(endpoint.getNode("csr.ctrl.buf_en"));
+    lEndpoint.ctr_rst = resolve(endpoint.getNode("csr.ctrl.ctr_rst"));
+    lEndpoint.tgrp = resolve(endpoint.getNode("csr.ctrl.tgrp"));
+
+    on_write(endpoint.getNode("csr.ctrl"), [this, lIndex](uint32_t) {
+        Endpoint& lEndpoint = m_endpoints.at(lIndex);
+        if (!get_field(lEndpoint.buf_en)) {
+            lEndpoint.buffer.clear();
+            lEndpoint.buffer_error = false;
+        }
+        if (get_field(lEndpoint.ctr_rst)) {
+            std::fill(lEndpoint.counters.begin(), lEndpoint.counters.end(), 0);
+            lEndpoint.event_counter = 0;
+        }
+    });
+
+    // Endpoints are ready as soon as they are enabled
+    const uhal::Node& lStat = endpoint.getNode("csr.stat");
+    uint32_t lBufErr = lStat.getNode("buf_err").getMask();
+    uint32_t lBufWarn = lStat.getNode("buf_warn").getMask();
+    uint32_t lEpRdy = lStat.getNode("ep_rdy").getMask();
+    uint32_t lEpStat = lStat.getNode("ep_stat").getMask();
+    uint32_t lInRun = lStat.getNode("in_run").getMask();
+    on_read(lStat, [=]() {
+        const Endpoint& lEndpoint = m_endpoints.at(lIndex);
+        bool lReady = get_field(lEndpoint.ep_en);
+        uint32_t lGroup = get_field(lEndpoint.tgrp);
+        return pack(lBufErr, lEndpoint.buffer_error)
+             | pack(lBufWarn, lEndpoint.buffer.size() > m_config.buffer_depth / 2)
+             | pack(lEpRdy, lReady)
+             | pack(lEpStat, lReady ? 0x8 : 0x0)
+             | pack(lInRun, lReady && lGroup < m_partitions.size() && m_partitions.at(lGroup).in_run);
+    });
+
+    on_block_read(endpoint.getNode("tstamp"), [this](uint32_t i) {
+        uint64_t lTimestamp = get_tick(m_now);
+        return static_cast<uint32_t>(i ? lTimestamp >> 32 : lTimestamp);
+    });
+    on_read(endpoint.getNode("evtctr"), [this, lIndex]() { return m_endpoints.at(lIndex).event_counter; });
+
+    uint32_t lCountMask = endpoint.getNode("buf.count").getMask();
+    on_read(endpoint.getNode("buf.count"), [this, lIndex, lCountMask]() {
+        return pack(lCountMask, m_endpoints.at(lIndex).buffer.size());
+    });
+    on_read(endpoint.getNode("buf.data"), [this, lIndex]() {
+        std::deque<uint32_t>& lBuffer = m_endpoints.at(lIndex).buffer;
+        if (lBuffer.empty()) return 0x0u;
+        uint32_t lWord = lBuffer.front();
+        lBuffer.pop_front();
+        return lWord;
+    });
+
+    on_block_read(endpoint.getNode("ctrs"), [this, lIndex](uint32_t i) {
+        const Endpoint& lEndpoint = m_endpoints.at(lIndex);
+        return i < lEndpoint.counters.size() ? lEndpoint.counters.at(i) : 0x0;
+    });
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::reset_state() {
+    m_registers.clear();
+    m_acmd_done = 0;
+
+    for (auto& lGenerator : m_generators) lGenerator = {0x0, 0};
+    std::fill(m_gen_accepted.begin(), m_gen_accepted.end(), 0);
+    std::fill(m_gen_rejected.begin(), m_gen_rejected.end(), 0);
+
+    for (auto& lPartition : m_partitions) {
+        lPartition.in_run = false;
+        lPartition.run_pending = false;
+        lPartition.buffer_error = false;
+        lPartition.event_counter = 0;
+        lPartition.buffer.clear();
+        lPartition.accepted.assign(kNumberOfCounters, 0);
+        lPartition.rejected.assign(kNumberOfCounters, 0);
+    }
+
+    for (auto& lEndpoint : m_endpoints) {
+        lEndpoint.buffer_error = false;
+        lEndpoint.event_counter = 0;
+        lEndpoint.buffer.clear();
+        lEndpoint.counters.assign(kNumberOfCounters, 0);
+    }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint64_t
+SimulatedBoard::get_tick(std::chrono::steady_clock::time_point time) const {
+    auto lElapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_epoch).count();
+    return m_epoch_timestamp + lElapsed * (g_dune_sp_clock_in_hz / 1000000) / 1000;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint64_t
+SimulatedBoard::get_period(const Generator& generator) const {
+    // Rate = (50MHz / 2^(d+8)) / p, as programmed by FakeTriggerConfig
+    uint32_t lDivisor = unpack(m_gen_masks.rate_div_d, generator.ctrl);
+    uint32_t lPrescale = unpack(m_gen_masks.rate_div_p, generator.ctrl);
+    return (256ull << lDivisor) * (lPrescale ? lPrescale : 256);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint64_t
+SimulatedBoard::get_interval(const Generator& generator) {
+    uint64_t lPeriod = get_period(generator);
+    if (!(generator.ctrl & m_gen_masks.patt)) return lPeriod;
+
+    std::exponential_distribution<double> lInterval(1. / lPeriod);
+    return std::max<uint64_t>(1, lInterval(m_random));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::update() {
+    m_now = std::chrono::steady_clock::now();
+
+    for (auto& lPartition : m_partitions) {
+        if (lPartition.run_pending && m_now >= lPartition.run_deadline) {
+            lPartition.in_run = !lPartition.in_run;
+            lPartition.run_pending = false;
+        }
+    }
+
+    uint64_t lTick = get_tick(m_now);
+    for (uint32_t i=0; i < m_generators.size(); ++i) {
+        Generator& lGenerator = m_generators.at(i);
+        if (!(lGenerator.ctrl & m_gen_masks.en)) continue;
+
+        while (lGenerator.next <= lTick) {
+            issue_command(i, unpack(m_gen_masks.type, lGenerator.ctrl), lGenerator.next);
+            lGenerator.next += get_interval(lGenerator);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedBoard::issue_command(uint32_t channel, uint32_t command, uint64_t timestamp) {
+    ++m_commands;
+    ++m_gen_accepted.at(channel % kNumberOfCounters);
+
+    uint32_t lCounter = command % kNumberOfCounters;
+    bool lTrigger = command >= 0x8 && command < 0x10;
+
+    // Partitions take every command while in run, and triggers only when enabled and unmasked
+    std::vector<bool> lAccepted(m_partitions.size(), false);
+    for (uint32_t i=0; i < m_partitions.size(); ++i) {
+        Partition& lPartition = m_partitions.at(i);
+        if (!get_field(lPartition.part_en)) continue;
+
+        bool lAccept = lPartition.in_run && (!lTrigger || (get_field(lPartition.trig_en) && ((get_field(lPartition.trig_mask) >> (command - 0x8)) & 0x1)));
+        if (!lAccept) {
+            ++lPartition.rejected.at(lCounter);
+            continue;
+        }
+
+        lAccepted.at(i) = true;
+        ++lPartition.accepted.at(lCounter);
+        ++lPartition.event_counter;
+        if (get_field(lPartition.buf_en)) push_event(lPartition.buffer, lPartition.buffer_error, command, timestamp, lPartition.event_counter);
+    }
+
+    for (auto& lEndpoint : m_endpoints) {
+        if (!get_field(lEndpoint.ep_en)) continue;
+        ++lEndpoint.counters.at(lCounter);
+
+        uint32_t lGroup = get_field(lEndpoint.tgrp);
+        if (lGroup >= lAccepted.size() || !lAccepted.at(lGroup)) continue;
+
+        ++lEndpoint.event_counter;
+        if (get_field(lEndpoint.buf_en)) push_event(lEndpoint.buffer, lEndpoint.buffer_error, command, timestamp, lEndpoint.event_counter);
+    }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+bool
+SimulatedBoard::push_event(std::deque<uint32_t>& buffer, bool& buffer_error, uint32_t command, uint64_t timestamp, uint32_t event_counter) {
+    if (buffer.size() + PartitionNode::kWordsPerEvent > m_config.buffer_depth) {
+        buffer_error = true;
+        return false;
+    }
+
+    buffer.push_back(kEventHeader);
+    buffer.push_back(command);
+    buffer.push_back(static_cast<uint32_t>(timestamp));
+    buffer.push_back(static_cast<uint32_t>(timestamp >> 32));
+    buffer.push_back(event_counter);
+    buffer.push_back(0x0);
+    return true;
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
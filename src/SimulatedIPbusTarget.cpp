@@ -0,0 +1,180 @@
+#include "timing/SimulatedIPbusTarget.hpp"
+
+namespace dunedaq {
+namespace timing {
+
+//-----------------------------------------------------------------------------
+SimulatedIPbusTarget::SimulatedIPbusTarget(SimulatedBoard& board) :
+    m_board(board),
+    m_next_id(1),
+    m_packets(0),
+    m_transactions(0),
+    m_bytes(0) {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+SimulatedIPbusTarget::~SimulatedIPbusTarget() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+bool
+SimulatedIPbusTarget::handle(const std::vector<uint32_t>& request, std::vector<uint32_t>& reply) {
+    if (request.empty()) return false;
+
+    bool lSwapped = false;
+    uint32_t lHeader = request.front();
+    if (!is_packet_header(lHeader)) {
+        lHeader = __builtin_bswap32(lHeader);
+        if (!is_packet_header(lHeader)) return false;
+        lSwapped = true;
+    }
+
+    std::vector<uint32_t> lRequest(request);
+    if (lSwapped) for (auto& lWord : lRequest) lWord = __builtin_bswap32(lWord);
+
+    uint32_t lId = (lHeader >> 8) & 0xffff;
+    switch (lHeader & 0xf) {
+        case 0x0:
+            if (!handle_control(lRequest, lId, reply)) return false;
+            break;
+        case 0x1:
+            handle_status(lHeader, reply);
+            break;
+        case 0x2:
+            if (!find_reply(lId, reply)) return false;
+            break;
+        default:
+            return false;
+    }
+
+    if (lSwapped) for (auto& lWord : reply) lWord = __builtin_bswap32(lWord);
+    return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+bool
+SimulatedIPbusTarget::is_packet_header(uint32_t header) {
+    return (header >> 28) == 0x2 && (header & 0xf0) == 0xf0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+bool
+SimulatedIPbusTarget::handle_control(const std::vector<uint32_t>& request, uint32_t id, std::vector<uint32_t>& reply) {
+    if (id) {
+        // Repeated packets get the same reply; out of sequence ones are dropped
+        if (id != m_next_id) return find_reply(id, reply);
+        m_next_id = (m_next_id == 0xffff) ? 1 : m_next_id + 1;
+    }
+
+    reply.clear();
+    reply.push_back(request.front());
+    execute(request, reply);
+    ++m_packets;
+    m_bytes += (request.size() + reply.size()) * sizeof(uint32_t);
+
+    if (id) {
+        m_replies.emplace_back(id, reply);
+        if (m_replies.size() > kReplyBuffers) m_replies.pop_front();
+    }
+    return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedIPbusTarget::handle_status(uint32_t header, std::vector<uint32_t>& reply) {
+    reply.assign(16, 0x0);
+    reply.at(0) = header;
+    reply.at(1) = kMTU;
+    reply.at(2) = kReplyBuffers;
+    reply.at(3) = 0x200000f0 | (m_next_id << 8);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+bool
+SimulatedIPbusTarget::find_reply(uint32_t id, std::vector<uint32_t>& reply) const {
+    for (auto& lReply : m_replies) {
+        if (lReply.first != id) continue;
+        reply = lReply.second;
+        return true;
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+SimulatedIPbusTarget::execute(const std::vector<uint32_t>& request, std::vector<uint32_t>& reply) {
+    size_t i = 1;
+    while (i < request.size()) {
+        uint32_t lHeader = request.at(i);
+        uint32_t lWords = (lHeader >> 8) & 0xff;
+        uint32_t lType = (lHeader >> 4) & 0xf;
+        uint32_t lReplyHeader = lHeader & 0xfffffff0;
+
+        if ((lHeader >> 28) != 0x2 || (lHeader & 0xf) != 0xf || i + 1 >= request.size()) {
+            reply.push_back(lReplyHeader | 0x1); // Bad header
+            return;
+        }
+
+        uint32_t lAddress = request.at(i + 1);
+        switch (lType) {
+            case 0x0: // Read
+            case 0x2: // Non-incrementing read
+                reply.push_back(lReplyHeader);
+                for (uint32_t j=0; j < lWords; ++j) reply.push_back(m_board.read(lType ? lAddress : lAddress + j));
+                i += 2;
+                break;
+            case 0x1: // Write
+            case 0x3: // Non-incrementing write
+                if (i + 2 + lWords > request.size()) {
+                    reply.push_back(lReplyHeader | 0x1);
+                    return;
+                }
+                for (uint32_t j=0; j < lWords; ++j) m_board.write(lType == 0x3 ? lAddress : lAddress + j, request.at(i + 2 + j));
+                reply.push_back(lReplyHeader);
+                i += 2 + lWords;
+                break;
+            case 0x4: // Read-modify-write bits
+                if (i + 4 > request.size()) {
+                    reply.push_back(lReplyHeader | 0x1);
+                    return;
+                }
+                reply.push_back(lReplyHeader);
+                reply.push_back(m_board.read(lAddress));
+                m_board.write(lAddress, (reply.back() & request.at(i + 2)) | request.at(i + 3));
+                i += 4;
+                break;
+            case 0x5: // Read-modify-write sum
+                if (i + 3 > request.size()) {
+                    reply.push_back(lReplyHeader | 0x1);
+                    return;
+                }
+                reply.push_back(lReplyHeader);
+                reply.push_back(m_board.read(lAddress));
+                m_board.write(lAddress, reply.back() + request.at(i + 2));
+                i += 3;
+                break;
+            default:
+                reply.push_back(lReplyHeader | 0x1);
+                return;
+        }
+        ++m_transactions;
+    }
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
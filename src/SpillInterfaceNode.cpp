@@ -37,7 +37,7 @@ void
 SpillInterfaceNode::enable() const {
     getNode("csr.ctrl.src").write(0);
     getNode("csr.ctrl.en").write(1);
-    getClient().dispatch();
+    counted_dispatch(getClient());
     TLOG() << "Spill interface enabled";
 }
 //-----------------------------------------------------------------------------
@@ -47,7 +47,7 @@ SpillInterfaceNode::enable() const {
 void
 SpillInterfaceNode::disable() const {
     getNode("csr.ctrl.en").write(0);
-    getClient().dispatch();
+    counted_dispatch(getClient());
     TLOG() << "Spill interface disabled";
 }
 //-----------------------------------------------------------------------------
@@ -68,7 +68,7 @@ SpillInterfaceNode::enable_fake_spills(uint32_t cycle_length, uint32_t spill_len
     getNode("csr.ctrl.fake_spill_len").write(spill_length);
     getNode("csr.ctrl.src").write(1);
     getNode("csr.ctrl.en").write(1);
-    getClient().dispatch();
+    counted_dispatch(getClient());
     TLOG() << "Fake spills enabled";
 }
 //-----------------------------------------------------------------------------
@@ -78,7 +78,7 @@ SpillInterfaceNode::enable_fake_spills(uint32_t cycle_length, uint32_t spill_len
 bool
 SpillInterfaceNode::read_in_spill() const {
     auto lInSpill = getNode("csr.stat.in_spill").read();
-    getClient().dispatch();
+    counted_dispatch(getClient());
     return lInSpill.value();
 }
 //------------------------------------------------------------------------------
@@ -0,0 +1,352 @@
+#include "timing/StatusSink.hpp"
+
+#include "timing/BinaryCodec.hpp"
+#include "timing/toolbox.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace dunedaq {
+namespace timing {
+
+namespace {
+
+void append_json_string(std::string& json, const std::string& text) {
+    json += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': json += "\\\""; break;
+            case '\\': json += "\\\\"; break;
+            case '\n': json += "\\n"; break;
+            case '\t': json += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char lEscaped[8];
+                    std::snprintf(lEscaped, sizeof(lEscaped), "\\u%04x", c);
+                    json += lEscaped;
+                } else {
+                    json += c;
+                }
+        }
+    }
+    json += '"';
+}
+
+void append_json_number(std::string& json, double value) {
+    if (!std::isfinite(value)) {
+        json += "null";
+        return;
+    }
+    char lNumber[32];
+    std::snprintf(lNumber, sizeof(lNumber), "%.17g", value);
+    json += lNumber;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+void
+StatusSink::add_registers(const std::map<std::string, uhal::ValWord<uint32_t>>& registers) {
+    for (auto& lRegister : registers) add_register(lRegister.first, lRegister.second.value());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TextStatusRenderer::TextStatusRenderer() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TextStatusRenderer::~TextStatusRenderer() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+TextStatusRenderer::begin_section(const std::string& name) {
+    flush_rows();
+    m_sections.push_back(name);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+TextStatusRenderer::end_section() {
+    flush_rows();
+    if (m_sections.size()) m_sections.pop_back();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+TextStatusRenderer::add_register(const std::string& name, uint64_t value) {
+    m_rows.emplace_back(name, format_reg_value(value));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+TextStatusRenderer::add_flag(const std::string& name, bool value) {
+    m_rows.emplace_back(name, value ? "1" : "0");
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+TextStatusRenderer::add_number(const std::string& name, double value, const std::string& unit) {
+    char lNumber[32];
+    std::snprintf(lNumber, sizeof(lNumber), "%.2f", value);
+    m_rows.emplace_back(name, unit.size() ? std::string(lNumber) + " " + unit : std::string(lNumber));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+TextStatusRenderer::add_text(const std::string& name, const std::string& value) {
+    m_rows.emplace_back(name, value);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+TextStatusRenderer::add_counters(const std::string& name, const std::vector<std::string>& labels, const std::vector<uint32_t>& values) {
+    flush_rows();
+
+    // One row per value, unlabelled ones by index
+    std::vector<std::string> lLabels(labels.begin(), labels.begin() + std::min(labels.size(), values.size()));
+    for (uint32_t i=lLabels.size(); i < values.size(); ++i) lLabels.push_back(std::to_string(i));
+
+    m_text += format_counters_table(std::vector<std::vector<uint32_t>>{values}, {name}, join(m_sections, " / "), lLabels);
+    m_text += '\n';
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+TextStatusRenderer::flush_rows() {
+    if (m_rows.empty()) return;
+
+    m_text += format_reg_table(m_rows, join(m_sections, " / "));
+    m_text += '\n';
+    m_rows.clear();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+JsonStatusRenderer::JsonStatusRenderer() :
+    m_json("{"),
+    m_first_in_section{true} {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+JsonStatusRenderer::~JsonStatusRenderer() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+JsonStatusRenderer::begin_section(const std::string& name) {
+    add_key(name);
+    m_json += '{';
+    m_first_in_section.push_back(true);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+JsonStatusRenderer::end_section() {
+    // The top level object is only closed by get_json
+    if (m_first_in_section.size() < 2) return;
+    m_json += '}';
+    m_first_in_section.pop_back();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+JsonStatusRenderer::add_register(const std::string& name, uint64_t value) {
+    add_key(name);
+    m_json += std::to_string(value);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+JsonStatusRenderer::add_flag(const std::string& name, bool value) {
+    add_key(name);
+    m_json += value ? "true" : "false";
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+JsonStatusRenderer::add_number(const std::string& name, double value, const std::string& unit) {
+    add_key(name);
+    if (unit.empty()) {
+        append_json_number(m_json, value);
+        return;
+    }
+    m_json += "{\"value\":";
+    append_json_number(m_json, value);
+    m_json += ",\"unit\":";
+    append_json_string(m_json, unit);
+    m_json += '}';
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+JsonStatusRenderer::add_text(const std::string& name, const std::string& value) {
+    add_key(name);
+    append_json_string(m_json, value);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+JsonStatusRenderer::add_counters(const std::string& name, const std::vector<std::string>& labels, const std::vector<uint32_t>& values) {
+    add_key(name);
+    m_json += '{';
+    for (uint32_t i=0; i < values.size(); ++i) {
+        if (i) m_json += ',';
+        append_json_string(m_json, i < labels.size() ? labels.at(i) : std::to_string(i));
+        m_json += ':';
+        m_json += std::to_string(values.at(i));
+    }
+    m_json += '}';
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::string
+JsonStatusRenderer::get_json() const {
+    return m_json + std::string(m_first_in_section.size(), '}');
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+JsonStatusRenderer::add_key(const std::string& name) {
+    if (!m_first_in_section.back()) m_json += ',';
+    m_first_in_section.back() = false;
+    append_json_string(m_json, name);
+    m_json += ':';
+}
+//-----------------------------------------------------------------------------
+
+
+// Static data member initialization
+const uint32_t BinaryStatusRenderer::kBinaryStatusVersion = 1;
+
+//-----------------------------------------------------------------------------
+BinaryStatusRenderer::BinaryStatusRenderer() {
+    binary_codec::Writer(m_buffer).put(kBinaryStatusVersion);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+BinaryStatusRenderer::~BinaryStatusRenderer() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+BinaryStatusRenderer::begin_section(const std::string& name) {
+    binary_codec::Writer lWriter(m_buffer);
+    lWriter.put<uint8_t>(kBeginSection);
+    binary_codec::encode(lWriter, name);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+BinaryStatusRenderer::end_section() {
+    binary_codec::Writer(m_buffer).put<uint8_t>(kEndSection);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+BinaryStatusRenderer::add_register(const std::string& name, uint64_t value) {
+    binary_codec::Writer lWriter(m_buffer);
+    lWriter.put<uint8_t>(kRegister);
+    binary_codec::encode(lWriter, name);
+    binary_codec::encode(lWriter, value);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+BinaryStatusRenderer::add_flag(const std::string& name, bool value) {
+    binary_codec::Writer lWriter(m_buffer);
+    lWriter.put<uint8_t>(kFlag);
+    binary_codec::encode(lWriter, name);
+    binary_codec::encode(lWriter, value);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+BinaryStatusRenderer::add_number(const std::string& name, double value, const std::string& unit) {
+    binary_codec::Writer lWriter(m_buffer);
+    lWriter.put<uint8_t>(kNumber);
+    binary_codec::encode(lWriter, name);
+    binary_codec::encode(lWriter, value);
+    binary_codec::encode(lWriter, unit);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+BinaryStatusRenderer::add_text(const std::string& name, const std::string& value) {
+    binary_codec::Writer lWriter(m_buffer);
+    lWriter.put<uint8_t>(kText);
+    binary_codec::encode(lWriter, name);
+    binary_codec::encode(lWriter, value);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+BinaryStatusRenderer::add_counters(const std::string& name, const std::vector<std::string>& labels, const std::vector<uint32_t>& values) {
+    binary_codec::Writer lWriter(m_buffer);
+    lWriter.put<uint8_t>(kCounters);
+    binary_codec::encode(lWriter, name);
+    binary_codec::encode(lWriter, labels);
+    binary_codec::encode(lWriter, values);
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
@@ -47,7 +47,7 @@ TLUIONode::reset(const std::string& clock_config_file) const {
 	getNode("csr.ctrl.rst_i2c").write(0x1);
 	getNode("csr.ctrl.rst_i2c").write(0x0);
 
-	getClient().dispatch();
+	counted_dispatch(getClient());
 
 	// enclustra i2c switch stuff
 	try {
@@ -100,7 +100,7 @@ TLUIONode::reset(const std::string& clock_config_file) const {
 
 	getNode("csr.ctrl.rst_lock_mon").write(0x1);
 	getNode("csr.ctrl.rst_lock_mon").write(0x0);
-	getClient().dispatch();
+	counted_dispatch(getClient());
 
 	TLOG() << "Reset done";
 }
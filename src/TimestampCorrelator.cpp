@@ -0,0 +1,183 @@
+#include "timing/TimestampCorrelator.hpp"
+
+#include "timing/toolbox.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace dunedaq {
+namespace timing {
+
+// Static data member initialization
+const double TimestampCorrelator::kNominalTicksPerNs = g_dune_sp_clock_in_hz / 1e9;
+const double TimestampCorrelator::kUnknownDriftBound = 1e-4;
+
+//-----------------------------------------------------------------------------
+TimestampCorrelator::TimestampCorrelator(std::function<uint64_t()> read_timestamp, std::chrono::nanoseconds max_error, uint32_t samples_per_update, uint32_t history) :
+    m_read_timestamp(read_timestamp),
+    m_max_error(max_error),
+    m_samples_per_update(std::max(samples_per_update, 1u)),
+    m_history(std::max(history, 1u)),
+    m_updates(0),
+    m_intercept(0.),
+    m_rate_correction(0.),
+    m_residual(0.),
+    m_drift_error(kUnknownDriftBound) {
+    update();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TimestampCorrelator::~TimestampCorrelator() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TimestampEstimate
+TimestampCorrelator::now() {
+    TimestampEstimate lEstimate = estimate(std::chrono::steady_clock::now());
+
+    // A fresh update cannot do better than its own round trip and the fit residual
+    auto lFloor = m_points.back().error + std::chrono::nanoseconds(static_cast<int64_t>(std::ceil(m_residual / kNominalTicksPerNs)));
+
+    if (lEstimate.error > m_max_error && lEstimate.error > 2 * lFloor) {
+        update();
+        lEstimate = estimate(std::chrono::steady_clock::now());
+    }
+    return lEstimate;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TimestampEstimate
+TimestampCorrelator::estimate(std::chrono::steady_clock::time_point host_time) const {
+    const CorrelationPoint& lNewest = m_points.back();
+
+    double lDt = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(host_time - lNewest.host_time).count();
+
+    // Timestamps do not fit in a double's mantissa: only the offset from the newest point goes through floating point
+    int64_t lDelta = std::llround(m_intercept + (kNominalTicksPerNs + m_rate_correction) * lDt);
+    double lError = lNewest.error.count() + m_residual / kNominalTicksPerNs + m_drift_error * std::fabs(lDt);
+
+    return {lNewest.timestamp + lDelta, std::chrono::nanoseconds(static_cast<int64_t>(std::ceil(lError)))};
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+TimestampCorrelator::update() {
+    CorrelationPoint lPoint = sample();
+
+    if (!m_points.empty()) {
+        TimestampEstimate lPredicted = estimate(lPoint.host_time);
+        double lDeviation = std::fabs(static_cast<double>(static_cast<int64_t>(lPoint.timestamp - lPredicted.timestamp))) / kNominalTicksPerNs;
+
+        if (lDeviation > (lPredicted.error + lPoint.error).count()) {
+            TLOG_DEBUG(0) << "Timestamp " << lDeviation << " ns away from the prediction, restarting the correlation";
+            m_points.clear();
+        }
+    }
+
+    m_points.push_back(lPoint);
+    while (m_points.size() > m_history) m_points.pop_front();
+
+    fit();
+    ++m_updates;
+
+    TLOG_DEBUG(1) << "Timestamp correlation updated from " << m_points.size() << " points, drift: " << get_drift() << ", error: " << lPoint.error.count() << " ns";
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+double
+TimestampCorrelator::get_drift() const {
+    return m_rate_correction / kNominalTicksPerNs;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+uint32_t
+TimestampCorrelator::get_number_of_updates() const {
+    return m_updates;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TimestampCorrelator::CorrelationPoint
+TimestampCorrelator::sample() const {
+    CorrelationPoint lBest{std::chrono::steady_clock::time_point(), 0, std::chrono::nanoseconds::max()};
+
+    for (uint32_t i=0; i < m_samples_per_update; ++i) {
+        auto lSent = std::chrono::steady_clock::now();
+        uint64_t lTimestamp = m_read_timestamp();
+        auto lReceived = std::chrono::steady_clock::now();
+
+        auto lHalfRoundTrip = std::chrono::duration_cast<std::chrono::nanoseconds>(lReceived - lSent) / 2;
+        if (lHalfRoundTrip >= lBest.error) continue;
+
+        lBest = {lSent + lHalfRoundTrip, lTimestamp, lHalfRoundTrip};
+    }
+    return lBest;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+TimestampCorrelator::fit() {
+    const CorrelationPoint& lNewest = m_points.back();
+    const CorrelationPoint& lOldest = m_points.front();
+
+    m_intercept = 0.;
+    m_rate_correction = 0.;
+    m_residual = 0.;
+    m_drift_error = kUnknownDriftBound;
+
+    // Least squares on the deviation from the nominal rate, relative to the newest point
+    std::vector<std::pair<double, double>> lDeviations;
+    for (auto& lPoint : m_points) {
+        double lDt = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(lPoint.host_time - lNewest.host_time).count();
+        double lDTicks = static_cast<int64_t>(lPoint.timestamp - lNewest.timestamp);
+        lDeviations.push_back({lDt, lDTicks - kNominalTicksPerNs * lDt});
+    }
+
+    double lMeanX(0.), lMeanY(0.);
+    for (auto& lDeviation : lDeviations) {
+        lMeanX += lDeviation.first;
+        lMeanY += lDeviation.second;
+    }
+    lMeanX /= lDeviations.size();
+    lMeanY /= lDeviations.size();
+
+    double lSxx(0.), lSxy(0.);
+    for (auto& lDeviation : lDeviations) {
+        lSxx += (lDeviation.first - lMeanX) * (lDeviation.first - lMeanX);
+        lSxy += (lDeviation.first - lMeanX) * (lDeviation.second - lMeanY);
+    }
+
+    if (lSxx <= 0.) return;
+
+    m_rate_correction = lSxy / lSxx;
+    m_intercept = lMeanY - m_rate_correction * lMeanX;
+
+    for (auto& lDeviation : lDeviations) {
+        m_residual = std::max(m_residual, std::fabs(lDeviation.second - m_intercept - m_rate_correction * lDeviation.first));
+    }
+
+    // The end points bound how well the slope is known
+    double lSpan = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(lNewest.host_time - lOldest.host_time).count();
+    m_drift_error = (lOldest.error + lNewest.error).count() / lSpan;
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
@@ -32,7 +32,7 @@ TimestampGeneratorNode::get_status(bool print_out) const {
 uhal::ValVector<uint32_t>
 TimestampGeneratorNode::read_raw_timestamp(bool dispatch) const {
 	auto lTimestamp = getNode("ctr.val").readBlock(2);
-	if (dispatch) getClient().dispatch();
+	if (dispatch) counted_dispatch(getClient());
     return lTimestamp;
 }
 //-----------------------------------------------------------------------------
@@ -53,7 +53,51 @@ TimestampGeneratorNode::set_timestamp(uint64_t timestamp) const {
 	uint32_t lNowH = (timestamp >> 32) & ((1UL<<32)-1);
     uint32_t lNowL = (timestamp >> 0) & ((1UL<<32)-1);
     getNode("ctr.set").writeBlock({lNowL, lNowH});
-    getClient().dispatch();
+    counted_dispatch(getClient());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TimestampOffset
+TimestampGeneratorNode::measure_host_offset(uint32_t samples) const {
+
+	TimestampOffset lBest{0, 0, 0, std::chrono::nanoseconds::max()};
+
+	for (uint32_t i=0; i < samples; ++i) {
+		auto lSent = std::chrono::system_clock::now();
+		auto lRawTimestamp = read_raw_timestamp();
+		auto lReceived = std::chrono::system_clock::now();
+
+		auto lRoundTrip = std::chrono::duration_cast<std::chrono::nanoseconds>(lReceived - lSent);
+		if (lRoundTrip >= lBest.round_trip) continue;
+
+		uint64_t lHostTimestamp = host_time_to_timestamp(lSent + lRoundTrip / 2);
+		lBest.offset = static_cast<int64_t>(tstamp2int(lRawTimestamp) - lHostTimestamp);
+		lBest.round_trip = lRoundTrip;
+	}
+
+	lBest.samples = samples;
+	if (samples) lBest.uncertainty = static_cast<uint64_t>(lBest.round_trip.count() / 2) * g_dune_sp_clock_in_hz / 1000000000;
+	return lBest;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TimestampOffset
+TimestampGeneratorNode::set_timestamp_from_host(uint32_t samples) const {
+
+	auto lBefore = measure_host_offset(samples);
+	auto lOneWay = samples ? lBefore.round_trip / 2 : std::chrono::nanoseconds(0);
+
+	auto lSent = std::chrono::system_clock::now();
+	set_timestamp(host_time_to_timestamp(lSent + lOneWay));
+	auto lWriteRoundTrip = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - lSent);
+
+	TLOG_DEBUG(0) << "Timestamp write compensated by " << lOneWay.count() << " ns, write round trip " << lWriteRoundTrip.count() << " ns";
+
+	return measure_host_offset(samples);
 }
 //-----------------------------------------------------------------------------
 
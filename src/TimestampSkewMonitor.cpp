@@ -0,0 +1,153 @@
+#include "timing/TimestampSkewMonitor.hpp"
+
+#include "timing/toolbox.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+namespace dunedaq {
+namespace timing {
+
+//-----------------------------------------------------------------------------
+TimestampSkewMonitor::TimestampSkewMonitor(const std::vector<TimestampSource>& sources, uint32_t history, uint64_t tolerance) :
+    m_sources(sources),
+    m_history(std::max(history, 1u)),
+    m_tolerance(tolerance),
+    m_next(0) {
+    m_measurements.reserve(m_history);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TimestampSkewMonitor::~TimestampSkewMonitor() {
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<TimestampSkew>
+TimestampSkewMonitor::measure() {
+
+    m_last_readings = read_all();
+
+    std::vector<TimestampSkew> lSkews;
+    for (uint32_t i=0; i < m_last_readings.size(); ++i) {
+        TimestampSkew lSkew = compare(m_last_readings.front(), m_last_readings.at(i));
+        lSkew.name = m_sources.at(i).name;
+
+        // Past offsets of this board, each with its own uncertainty
+        std::vector<TimestampSkew> lPast;
+        for (auto& lMeasurement : m_measurements) lPast.push_back(lMeasurement.at(i));
+
+        if (lPast.size() > 1) {
+            auto lMedian = lPast.begin() + lPast.size() / 2;
+            std::nth_element(lPast.begin(), lMedian, lPast.end(), [](const TimestampSkew& a, const TimestampSkew& b) {
+                return a.offset < b.offset;
+            });
+
+            lSkew.drift = lSkew.offset - lMedian->offset;
+            lSkew.drift_uncertainty = lSkew.uncertainty + lMedian->uncertainty;
+            lSkew.drifting = static_cast<uint64_t>(std::llabs(lSkew.drift)) > m_tolerance + lSkew.drift_uncertainty;
+            if (lSkew.drifting) {
+                ers::warning(TimestampSkewDrift(ERS_HERE, lSkew.name, lSkew.drift));
+            }
+        }
+
+        TLOG_DEBUG(1) << lSkew.name << " offset: " << lSkew.offset << " +/- " << lSkew.uncertainty << " ticks, drift: " << lSkew.drift;
+        lSkews.push_back(lSkew);
+    }
+
+    if (m_measurements.size() < m_history) {
+        m_measurements.push_back(lSkews);
+    } else {
+        m_measurements.at(m_next) = lSkews;
+    }
+    m_next = (m_next + 1) % m_history;
+
+    return lSkews;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TimestampSkew
+TimestampSkewMonitor::get_pairwise_offset(uint32_t from, uint32_t to) const {
+    TimestampSkew lSkew = compare(m_last_readings.at(from), m_last_readings.at(to));
+    lSkew.name = m_sources.at(from).name + " -> " + m_sources.at(to).name;
+    return lSkew;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<std::vector<TimestampSkew>>
+TimestampSkewMonitor::get_history() const {
+    if (m_measurements.size() < m_history) return m_measurements;
+
+    std::vector<std::vector<TimestampSkew>> lHistory(m_measurements.begin() + m_next, m_measurements.end());
+    lHistory.insert(lHistory.end(), m_measurements.begin(), m_measurements.begin() + m_next);
+    return lHistory;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<TimestampSkewMonitor::TimestampReading>
+TimestampSkewMonitor::read_all() const {
+
+    // Every board gets its own thread, released together once all are running
+    std::promise<void> lRelease;
+    std::shared_future<void> lStart = lRelease.get_future().share();
+    std::vector<std::promise<void>> lRunning(m_sources.size());
+    std::vector<std::future<void>> lStarted;
+
+    std::vector<std::future<TimestampReading>> lPendingReadings;
+    for (uint32_t i=0; i < m_sources.size(); ++i) {
+        const TimestampSource& lSource = m_sources.at(i);
+        std::promise<void>& lReady = lRunning.at(i);
+        lStarted.push_back(lReady.get_future());
+        lPendingReadings.push_back(std::async(std::launch::async, [&lSource, &lReady, lStart]() {
+            lReady.set_value();
+            lStart.wait();
+
+            auto lSent = std::chrono::steady_clock::now();
+            uint64_t lTimestamp = lSource.read_timestamp();
+            auto lReceived = std::chrono::steady_clock::now();
+
+            auto lHalfRoundTrip = std::chrono::duration_cast<std::chrono::nanoseconds>(lReceived - lSent) / 2;
+            return TimestampReading{lSent + lHalfRoundTrip, lTimestamp, lHalfRoundTrip};
+        }));
+    }
+    for (auto& lThreadStarted : lStarted) lThreadStarted.wait();
+    lRelease.set_value();
+
+    std::vector<TimestampReading> lReadings;
+    for (auto& lPendingReading : lPendingReadings) {
+        lReadings.push_back(lPendingReading.get());
+    }
+    return lReadings;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+TimestampSkew
+TimestampSkewMonitor::compare(const TimestampReading& from, const TimestampReading& to) const {
+    const double lTicksPerNs = g_dune_sp_clock_in_hz / 1e9;
+
+    double lDt = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(to.host_time - from.host_time).count();
+
+    TimestampSkew lSkew;
+    lSkew.offset = static_cast<int64_t>(to.timestamp - from.timestamp) - std::llround(lDt * lTicksPerNs);
+    lSkew.uncertainty = static_cast<uint64_t>(std::ceil((from.error + to.error).count() * lTicksPerNs));
+    lSkew.drift = 0;
+    lSkew.drift_uncertainty = lSkew.uncertainty;
+    lSkew.drifting = false;
+    return lSkew;
+}
+//-----------------------------------------------------------------------------
+
+} // namespace timing
+} // namespace dunedaq
@@ -1,5 +1,8 @@
 #include "timing/TimingNode.hpp"
 
+#include <algorithm>
+#include <iostream>
+
 namespace dunedaq {
 namespace timing {
 
@@ -15,6 +18,45 @@ TimingNode::~TimingNode() {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+std::string
+TimingNode::get_status(bool print_out) const {
+	TextStatusRenderer lRenderer;
+	report_status(lRenderer);
+
+	if (print_out) std::cout << lRenderer.get_text();
+	return lRenderer.get_text();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+TimingNode::report_status(StatusSink& sink) const {
+	const std::vector<std::string> lNodeIds = getNodes();
+	auto lHasNode = [&lNodeIds](const std::string& id) { return std::find(lNodeIds.begin(), lNodeIds.end(), id) != lNodeIds.end(); };
+
+	std::map<std::string,uhal::ValWord<uint32_t>> lControls, lState;
+	if (lHasNode("csr.ctrl")) lControls = read_sub_nodes(getNode("csr.ctrl"), false);
+	if (lHasNode("csr.stat")) lState = read_sub_nodes(getNode("csr.stat"), false);
+	counted_dispatch(getClient());
+
+	sink.begin_section(getId());
+	if (lControls.size()) {
+		sink.begin_section("Controls");
+		sink.add_registers(lControls);
+		sink.end_section();
+	}
+	if (lState.size()) {
+		sink.begin_section("State");
+		sink.add_registers(lState);
+		sink.end_section();
+	}
+	sink.end_section();
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 std::map<std::string,uhal::ValWord<uint32_t>>
 TimingNode::read_sub_nodes(const uhal::Node& node, bool dispatch) const {
@@ -23,7 +65,7 @@ TimingNode::read_sub_nodes(const uhal::Node& node, bool dispatch) const {
 	std::map<std::string,uhal::ValWord<uint32_t>> lNodeNameValuePairs;
 
 	for (auto it=lNodeNames.begin(); it != lNodeNames.end(); ++it) lNodeNameValuePairs[*it] = node.getNode(*it).read();
-	if (dispatch) getClient().dispatch();
+	if (dispatch) counted_dispatch(getClient());
 	return lNodeNameValuePairs;
 }
 //-----------------------------------------------------------------------------
@@ -37,7 +79,7 @@ TimingNode::reset_sub_nodes(const uhal::Node& node, uint32_t aValue, bool dispat
 
 	for (auto it=lNodeNames.begin(); it != lNodeNames.end(); ++it) node.getNode(*it).write(aValue);
 
-    if (dispatch) getClient().dispatch();
+    if (dispatch) counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
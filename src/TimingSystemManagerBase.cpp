@@ -1,5 +1,8 @@
 #include "timing/TimingSystemManagerBase.hpp"
 
+#include <algorithm>
+#include <tuple>
+
 namespace dunedaq {
 namespace timing {
 
@@ -40,5 +43,47 @@ TimingSystemManagerBase::getNumberOfEndpoints() const {
 }
 //-----------------------------------------------------------------------------
 
+
+//-----------------------------------------------------------------------------
+std::vector<ActiveEndpointConfig>
+TimingSystemManagerBase::solve_endpoint_delays(const std::vector<EndpointRTTResult>& scan, uint32_t target_rtt) const {
+	
+	uint32_t lTarget = target_rtt;
+	for (auto& lResult : scan) {
+		lTarget = std::max(lTarget, static_cast<uint32_t>(lResult.measuredRTT));
+	}
+
+	std::vector<ActiveEndpointConfig> lConfigs;
+	for (auto& lResult : scan) {
+		ActiveEndpointConfig lConfig = mExpectedEndpoints.at(lResult.id);
+		uint32_t lCoarseDelay = lConfig.cdelay + lTarget - lResult.measuredRTT;
+
+		if (lCoarseDelay > g_max_coarse_delay) {
+			throw EndpointDelayOutOfRange(ERS_HERE, lConfig.id, lCoarseDelay);
+		}
+		lConfig.cdelay = lCoarseDelay;
+		lConfigs.push_back(lConfig);
+	}
+	TLOG() << "Endpoint delays solved for a target RTT of " << lTarget;
+	return lConfigs;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::vector<ActiveEndpointConfig>
+TimingSystemManagerBase::plan_endpoint_rtt_scan() const {
+	std::vector<ActiveEndpointConfig> lPlan;
+	for (auto it = mExpectedEndpoints.begin(); it != mExpectedEndpoints.end(); ++it) {
+		lPlan.push_back(it->second);
+	}
+
+	std::stable_sort(lPlan.begin(), lPlan.end(), [](const ActiveEndpointConfig& a, const ActiveEndpointConfig& b) {
+		return std::tie(a.fanout, a.mux, a.adr) < std::tie(b.fanout, b.mux, b.adr);
+	});
+	return lPlan;
+}
+//-----------------------------------------------------------------------------
+
 } // namespace timing
 } // namespace dunedaq
\ No newline at end of file
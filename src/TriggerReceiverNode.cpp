@@ -27,7 +27,7 @@ TriggerReceiverNode::get_status(bool print_out) const {
     auto lState = read_sub_nodes(getNode("csr.stat"), false);
     auto lControls = read_sub_nodes(getNode("csr.ctrl"), false);
     auto lCounters = getNode("ctrs").readBlock(0x10);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 
     lStatus << format_reg_table(lState, "Trigger rx state");
     lStatus << format_reg_table(lControls, "Trigger rx controls");
@@ -41,11 +41,40 @@ TriggerReceiverNode::get_status(bool print_out) const {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+void
+TriggerReceiverNode::report_status(StatusSink& sink) const {
+    auto lState = read_sub_nodes(getNode("csr.stat"), false);
+    auto lControls = read_sub_nodes(getNode("csr.ctrl"), false);
+    auto lCounters = getNode("ctrs").readBlock(getNode("ctrs").getSize());
+    counted_dispatch(getClient());
+
+    std::vector<std::string> lCommandLabels;
+    for (uint32_t i=0; i < lCounters.size(); ++i) {
+        auto lCommand = g_command_map.find(i);
+        lCommandLabels.push_back(lCommand != g_command_map.end() ? lCommand->second : std::to_string(i));
+    }
+
+    sink.begin_section("Trigger rx state");
+    sink.add_registers(lState);
+    sink.end_section();
+
+    sink.begin_section("Trigger rx controls");
+    sink.add_registers(lControls);
+    sink.end_section();
+
+    sink.begin_section("Trig rx counters");
+    sink.add_counters("Counters", lCommandLabels, lCounters.value());
+    sink.end_section();
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 void
 TriggerReceiverNode::enable() const {
     getNode("csr.ctrl.ep_en").write(0x1);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -54,7 +83,7 @@ TriggerReceiverNode::enable() const {
 void
 TriggerReceiverNode::disable() const {
     getNode("csr.ctrl.ep_en").write(0x0);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -64,7 +93,7 @@ void
 TriggerReceiverNode::reset() const {
     getNode("csr.ctrl.ep_en").write(0x0);
     getNode("csr.ctrl.ep_en").write(0x1);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -73,7 +102,7 @@ TriggerReceiverNode::reset() const {
 void
 TriggerReceiverNode::enable_triggers() const {
     getNode("csr.ctrl.ext_trig_en").write(0x1);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //------------------------------------------------------------------------------
 
@@ -82,7 +111,7 @@ TriggerReceiverNode::enable_triggers() const {
 void
 TriggerReceiverNode::disable_triggers() const {
     getNode("csr.ctrl.ext_trig_en").write(0x0);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //------------------------------------------------------------------------------
 
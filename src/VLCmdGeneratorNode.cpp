@@ -40,7 +40,7 @@ VLCmdGeneratorNode::switch_endpoint_sfp(uint32_t address, bool enable) const {
     getNode("csr.ctrl.tx_en").write(enable);
     getNode("csr.ctrl.go").write(0x1);
     getNode("csr.ctrl.go").write(0x0);
-    getClient().dispatch();
+    counted_dispatch(getClient());
 }
 //-----------------------------------------------------------------------------
 
@@ -48,6 +48,50 @@ VLCmdGeneratorNode::switch_endpoint_sfp(uint32_t address, bool enable) const {
 //-----------------------------------------------------------------------------
 void
 VLCmdGeneratorNode::apply_endpoint_delay(uint32_t address, uint32_t coarse_delay, uint32_t fine_delay, uint32_t phase_delay) const {
+    queue_endpoint_delay(address, coarse_delay, fine_delay, phase_delay);
+    counted_dispatch(getClient());
+
+    TLOG() << "Coarse delay " << format_reg_value(coarse_delay) << " applied";
+    TLOG() << "Fine delay   " << format_reg_value(fine_delay) << " applied";
+    TLOG() << "Phase delay  " << format_reg_value(phase_delay) << " applied";
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+VLCmdGeneratorNode::apply_endpoint_delays(const std::vector<ActiveEndpointConfig>& endpoints, uint32_t timeout) const {
+
+    for (auto& lEpt : endpoints) {
+        queue_endpoint_delay(lEpt.adr, lEpt.cdelay, lEpt.fdelay, lEpt.pdelay);
+        // go clears done before the next transaction of the packet is served, so done read
+        // back high means this command has already been sent, not that the previous one was
+        auto lDoneAfterGo = getNode("csr.stat.done").read();
+        counted_dispatch(getClient());
+
+        bool lDone = lDoneAfterGo.value();
+        auto lPoll = poll_until([this, &lDone]() {
+            if (!lDone) {
+                auto lDoneNow = getNode("csr.stat.done").read();
+                counted_dispatch(getClient());
+                lDone = lDoneNow.value();
+            }
+            return lDone;
+        }, std::chrono::milliseconds(timeout));
+
+        if (!lPoll.success) {
+            throw VLCmdTimeout(ERS_HERE, lEpt.adr);
+        }
+        TLOG_DEBUG(0) << lEpt.id << " delays applied; cdel: " << lEpt.cdelay << ", fdel: " << lEpt.fdelay << ", pdel: " << lEpt.pdelay;
+    }
+    TLOG() << "Delays applied to " << endpoints.size() << " endpoints";
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+VLCmdGeneratorNode::queue_endpoint_delay(uint32_t address, uint32_t coarse_delay, uint32_t fine_delay, uint32_t phase_delay) const {
     reset_sub_nodes(getNode("csr.ctrl"), false);
     getNode("csr.ctrl.tx_en").write(0x1);
     getNode("csr.ctrl.addr").write(address);
@@ -57,11 +101,6 @@ VLCmdGeneratorNode::apply_endpoint_delay(uint32_t address, uint32_t coarse_delay
     getNode("csr.ctrl.update").write(0x1);
     getNode("csr.ctrl.go").write(0x1);
     getNode("csr.ctrl.go").write(0x0);
-    getClient().dispatch();
-
-    TLOG() << "Coarse delay " << format_reg_value(coarse_delay) << " applied";
-    TLOG() << "Fine delay   " << format_reg_value(fine_delay) << " applied";
-    TLOG() << "Phase delay  " << format_reg_value(phase_delay) << " applied";
 }
 //-----------------------------------------------------------------------------
 
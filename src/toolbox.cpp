@@ -1,9 +1,13 @@
 #include "timing/toolbox.hpp"
+#include "timing/DispatchAccounting.hpp"
 
 // C++ Headers
 #include <time.h>
+#include <algorithm>
+#include <cmath>
 #include <cstdarg>
 #include <cstdlib>
+#include <limits>
 #include <stdio.h>
 #include <stdint.h>
 #include <vector>
@@ -35,7 +39,7 @@ snapshot(const uhal::Node& node) {
     for(string n :  node.getNodes()) {
         valWords.insert(make_pair(n, node.getNode(n).read()));
     }
-    node.getClient().dispatch();
+    counted_dispatch(node.getClient());
 
     Snapshot vals;
     std::map<string, uhal::ValWord<uint32_t> >::iterator it;
@@ -55,7 +59,7 @@ snapshot(const uhal::Node& node, const std::string& aRegex) {
     for(string n :  node.getNodes(aRegex)) {
         valWords.insert(make_pair(n, node.getNode(n).read()));
     }
-    node.getClient().dispatch();
+    counted_dispatch(node.getClient());
 
     Snapshot vals;
     std::map<string, uhal::ValWord<uint32_t> >::iterator it;
@@ -182,6 +186,62 @@ get_seconds_since_epoch() {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+uint64_t
+host_time_to_timestamp(std::chrono::system_clock::time_point aTime) {
+    const uint64_t lNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(aTime.time_since_epoch()).count();
+
+    // Split at the second to keep the product within 64 bits
+    return (lNanoseconds / 1000000000) * g_dune_sp_clock_in_hz + (lNanoseconds % 1000000000) * g_dune_sp_clock_in_hz / 1000000000;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::string
+format_unsigned_value(uint64_t aValue, uint32_t aBase) {
+    if (aBase != 16 && aBase != 10) {
+        TLOG() << "Unsupported number base: " << aBase;
+        aBase = 10;
+    }
+
+    char lDigits[24];
+    char* lEnd = lDigits + sizeof(lDigits);
+    char* lBegin = lEnd;
+
+    uint64_t lValue = aValue;
+    do {
+        *--lBegin = "0123456789abcdef"[lValue % aBase];
+        lValue /= aBase;
+    } while (lValue);
+
+    // Like std::showbase, no prefix for zero
+    if (aBase == 16 && aValue) {
+        *--lBegin = 'x';
+        *--lBegin = '0';
+    }
+    return std::string(lBegin, lEnd);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void
+append_centred(std::string& aOut, const std::string& aText, uint32_t aWidth, char aFill) {
+    if (aText.size() >= aWidth) {
+        aOut += aText;
+        return;
+    }
+
+    // An odd padding leaves the extra fill character in front
+    size_t lPadding = aWidth - aText.size();
+    aOut.append(lPadding - lPadding / 2, aFill);
+    aOut += aText;
+    aOut.append(lPadding / 2, aFill);
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 std::string 
 format_timestamp(uint64_t rawTimestamp) {
@@ -205,6 +265,68 @@ format_timestamp(uhal::ValVector< uint32_t > rawTimestamp) {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+uint64_t
+counter_increase(uint64_t aPrevious, uint64_t aCurrent, std::chrono::duration<double> aElapsed) {
+    if (aCurrent >= aPrevious) return aCurrent - aPrevious;
+
+    // Counters are cleared in normal operation: only a drop from near 2^32 that fits the elapsed time is a wrap
+    const uint64_t kCounterRange = static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()) + 1;
+    if (aPrevious < kCounterRange && aCurrent < kCounterRange) {
+        const uint64_t lWrapped = kCounterRange - aPrevious + aCurrent;
+        if (lWrapped <= std::max(aElapsed.count(), 0.) * g_dune_sp_clock_in_hz) return lWrapped;
+    }
+    return aCurrent;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+RTTStatistics
+compute_rtt_statistics(std::vector<uint64_t> aSamples, uint64_t aMaxSpread) {
+
+    RTTStatistics lStats = {static_cast<uint32_t>(aSamples.size()), 0, 0, 0, 0, 0., true};
+    if (aSamples.empty()) return lStats;
+
+    std::sort(aSamples.begin(), aSamples.end());
+    const uint64_t lMedian = aSamples[(aSamples.size()-1)/2];
+
+    std::vector<uint64_t> lDeviations;
+    for (auto lSample : aSamples) {
+        lDeviations.push_back(lSample > lMedian ? lSample - lMedian : lMedian - lSample);
+    }
+    std::sort(lDeviations.begin(), lDeviations.end());
+    const double lMAD = lDeviations[(lDeviations.size()-1)/2];
+
+    // 1.4826 scales the MAD to a standard deviation for normally distributed samples
+    const double lLimit = std::max(3. * 1.4826 * lMAD, static_cast<double>(aMaxSpread));
+
+    std::vector<uint64_t> lAccepted;
+    for (auto lSample : aSamples) {
+        double lDeviation = lSample > lMedian ? lSample - lMedian : lMedian - lSample;
+        if (lDeviation <= lLimit) lAccepted.push_back(lSample);
+    }
+
+    double lMean = 0.;
+    for (auto lSample : lAccepted) lMean += lSample;
+    lMean /= lAccepted.size();
+
+    double lVariance = 0.;
+    for (auto lSample : lAccepted) lVariance += (lSample - lMean) * (lSample - lMean);
+    lVariance /= lAccepted.size();
+
+    lStats.accepted = lAccepted.size();
+    lStats.min = lAccepted.front();
+    lStats.median = lAccepted[(lAccepted.size()-1)/2];
+    lStats.max = lAccepted.back();
+    lStats.stddev = std::sqrt(lVariance);
+    lStats.unstable = (lStats.max - lStats.min) > aMaxSpread || 5 * lStats.accepted < 4 * lStats.samples;
+
+    return lStats;
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 double convert_bits_to_float(uint64_t aBits, bool aIsDoublePrecision){
     uint32_t lMantissaShift = aIsDoublePrecision ? 52 : 23;
@@ -0,0 +1,288 @@
+/**
+ * @file format_tables_benchmark.cxx
+ *
+ * Times format_reg_table and format_counters_table against the
+ * boost::format implementations they replaced, and checks that both
+ * render the same text.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/toolbox.hpp"
+
+#include <boost/format.hpp>
+#include <boost/format/group.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace dunedaq::timing;
+
+namespace legacy {
+
+// The boost::format based table rendering, as it was before the single pass rewrite
+
+template <class T>
+std::string
+format_reg_value(T regValue, uint32_t base=16) {
+  std::stringstream lValueStream;
+  if (base == 16) {
+    lValueStream << std::showbase << std::hex;
+  } else {
+    lValueStream << std::dec;
+  }
+  lValueStream << regValue;
+  return lValueStream.str();
+}
+
+template<class T>
+std::string
+format_reg_table(T data, std::string title, std::vector<std::string> headers) {
+
+  uint32_t lTableWidth = 7;
+  uint32_t lRegColumnWidth = 0;
+  uint32_t lValColumnWidth = 3;
+  std::stringstream lTableStream;
+
+  for (auto it=data.begin(); it!=data.end(); ++it) {
+    lRegColumnWidth = lRegColumnWidth > it->first.size() ? lRegColumnWidth : it->first.size();
+    lValColumnWidth = lValColumnWidth > format_reg_value(it->second).size() ? lValColumnWidth : format_reg_value(it->second).size();
+  }
+
+  lRegColumnWidth = lRegColumnWidth > headers.at(0).size() ? lRegColumnWidth : headers.at(0).size();
+  lValColumnWidth = lValColumnWidth > headers.at(1).size() ? lValColumnWidth : headers.at(1).size();
+
+  lTableWidth = lTableWidth + lRegColumnWidth + lValColumnWidth;
+
+  if (title.size()) lTableStream << boost::format("%=s\n") % boost::io::group(std::setw(lTableWidth), std::setfill('-'), title);
+
+  if (headers.at(0).size() || headers.at(1).size()) {
+    lTableStream << boost::format("+-%=s-+-%=s-+\n") % boost::io::group(std::setw(lRegColumnWidth), std::setfill('-'), "")  % boost::io::group(std::setw(lValColumnWidth), std::setfill('-'), "");
+    lTableStream << boost::format("| %=s | %=s |\n") % boost::io::group(std::setw(lRegColumnWidth), headers.at(0)) % boost::io::group(std::setw(lValColumnWidth), headers.at(1));
+  }
+
+  lTableStream << boost::format("+-%=s-+-%=s-+\n") % boost::io::group(std::setw(lRegColumnWidth), std::setfill('-'), "")  % boost::io::group(std::setw(lValColumnWidth), std::setfill('-'), "");
+
+  for (auto it=data.begin(); it!=data.end(); ++it) {
+    lTableStream << boost::format("| %=s | %=s |\n") % boost::io::group(std::setw(lRegColumnWidth), it->first) % boost::io::group(std::setw(lValColumnWidth), format_reg_value(it->second));
+  }
+  lTableStream << boost::format("+-%=s-+-%=s-+\n") % boost::io::group(std::setw(lRegColumnWidth), std::setfill('-'), "")  % boost::io::group(std::setw(lValColumnWidth), std::setfill('-'), "");
+
+  return lTableStream.str();
+}
+
+template<class T>
+std::string format_counters_table(std::vector<T> aCounterNodes, std::vector<std::string> aCounterNodeTitles, std::string aTableTitle, std::vector<std::string> aCounterLabels, std::string aCounterLabelsHeader) {
+
+  uint32_t lCounterNodesNumber = aCounterNodes.size();
+  uint32_t lTableWidth = 4+(lCounterNodesNumber*3);
+
+  std::vector<std::string> lCounterNodeTitles = aCounterNodeTitles;
+  uint32_t lCounterNumber;
+  uint32_t lCounterLabelColumnWidth = 0;
+
+  std::stringstream lTableStream;
+
+  std::vector<std::string> lCounterLabels = aCounterLabels;
+  lCounterNumber = lCounterLabels.size();
+
+  for (auto it=lCounterLabels.begin(); it != lCounterLabels.end(); ++it) {
+    lCounterLabelColumnWidth = lCounterLabelColumnWidth > it->size() ? lCounterLabelColumnWidth : it->size();
+  }
+  lCounterLabelColumnWidth = lCounterLabelColumnWidth > aCounterLabelsHeader.size() ? lCounterLabelColumnWidth : aCounterLabelsHeader.size();
+
+  typedef std::vector<std::pair<std::string, std::string>> CounterValuesContainer;
+
+  std::vector<CounterValuesContainer> lCounterValueContainers;
+  std::vector<std::pair<uint32_t, uint32_t>> lCounterValueColumnWidths;
+
+  for (auto nodeIt=aCounterNodes.begin(); nodeIt!=aCounterNodes.end(); ++nodeIt) {
+
+    CounterValuesContainer lCounterValues;
+
+    uint32_t lCounterValueDecColumnWidth = 5;
+    uint32_t lCounterValueHexColumnWidth = 5;
+
+    for (auto counterIt=nodeIt->begin(); counterIt != nodeIt->end(); ++counterIt) {
+
+      std::string lCounterValueDec = format_reg_value(*counterIt,10);
+      std::string lCounterValueHex = format_reg_value(*counterIt,16);
+
+      lCounterValueDecColumnWidth = lCounterValueDecColumnWidth > lCounterValueDec.size() ? lCounterValueDecColumnWidth : lCounterValueDec.size();
+      lCounterValueHexColumnWidth = lCounterValueHexColumnWidth > lCounterValueHex.size() ? lCounterValueHexColumnWidth : lCounterValueHex.size();
+
+      lCounterValues.push_back(std::make_pair(lCounterValueDec, lCounterValueHex));
+    }
+
+    lCounterValueContainers.push_back(lCounterValues);
+    lCounterValueColumnWidths.push_back(std::make_pair(lCounterValueDecColumnWidth, lCounterValueHexColumnWidth));
+  }
+
+  std::vector<uint32_t> lCounterNodeTitleSizes;
+  std::stringstream lCounterTitlesRow;
+  lCounterTitlesRow << boost::format("| %=s |") % boost::io::group(std::setw(lCounterLabelColumnWidth), "");
+  lTableWidth = lTableWidth + lCounterLabelColumnWidth;
+  for (uint32_t i=0; i < lCounterNodesNumber; ++i) {
+    uint32_t lDecWidth = lCounterValueColumnWidths.at(i).first;
+    uint32_t lHexWidth = lCounterValueColumnWidths.at(i).second;
+
+    uint32_t lCounterTitleSize = lCounterNodeTitles.at(i).size();
+
+    if (lCounterTitleSize > (lDecWidth+lHexWidth+3)) {
+
+      if ((lCounterTitleSize-3)%2) ++lCounterTitleSize;
+
+      lCounterValueColumnWidths.at(i).first  = (lCounterTitleSize-3)/2;
+      lCounterValueColumnWidths.at(i).second = (lCounterTitleSize-3)/2;
+
+    } else {
+      lCounterTitleSize = (lDecWidth+lHexWidth+3);
+    }
+    lCounterTitlesRow << boost::format(" %=s |") % boost::io::group(std::setw(lCounterTitleSize), lCounterNodeTitles.at(i));
+    lCounterNodeTitleSizes.push_back(lCounterTitleSize);
+    lTableWidth = lTableWidth + lCounterTitleSize;
+  }
+  lCounterTitlesRow << std::endl;
+
+  std::stringstream lTitleRowBorder;
+  lTitleRowBorder << boost::format("+-%=s-+") % boost::io::group(std::setw(lCounterLabelColumnWidth), std::setfill('-'), "");
+  for (uint32_t i=0; i < lCounterNodesNumber; ++i) {
+    lTitleRowBorder << boost::format("-%=s-+") % boost::io::group(std::setw(lCounterNodeTitleSizes.at(i)), std::setfill('-'), "");
+  }
+  lTitleRowBorder << std::endl;
+
+  if (aTableTitle.size()) lTableStream << boost::format("%=s\n") % boost::io::group(std::setw(lTableWidth), std::setfill('-'), aTableTitle);
+
+  lTableStream << lTitleRowBorder.str();
+  lTableStream << lCounterTitlesRow.str();
+  lTableStream << lTitleRowBorder.str();
+
+  std::stringstream lCounterHeaders;
+  lCounterHeaders << boost::format("| %=s |") % boost::io::group(std::setw(lCounterLabelColumnWidth), aCounterLabelsHeader);
+  for (uint32_t j=0; j < lCounterNodesNumber; ++j) {
+      uint32_t lDecWidth = lCounterValueColumnWidths.at(j).first;
+      uint32_t lHexWidth = lCounterValueColumnWidths.at(j).second;
+      lCounterHeaders << boost::format(" %=s | %=s |") % boost::io::group(std::setw(lDecWidth), "cnts") % boost::io::group(std::setw(lHexWidth), "hex");
+  }
+  lTableStream << lCounterHeaders.str() << std::endl;
+
+  std::stringstream lRowBorder;
+  lRowBorder << boost::format("+-%=s-+") % boost::io::group(std::setw(lCounterLabelColumnWidth), std::setfill('-'), "");
+  for (uint32_t j=0; j < lCounterNodesNumber; ++j) {
+      uint32_t lDecWidth = lCounterValueColumnWidths.at(j).first;
+      uint32_t lHexWidth = lCounterValueColumnWidths.at(j).second;
+      lRowBorder << boost::format("-%=s-+-%=s-+") % boost::io::group(std::setw(lDecWidth), std::setfill('-'), "")  % boost::io::group(std::setw(lHexWidth), std::setfill('-'), "");
+    }
+  lRowBorder << std::endl;
+  lTableStream << lRowBorder.str();
+
+  for (uint32_t i=0; i < lCounterNumber; ++i) {
+    std::stringstream lTableRowStream;
+
+    lTableRowStream << boost::format("| %=s |") % boost::io::group(std::setw(lCounterLabelColumnWidth), lCounterLabels.at(i));
+
+    for (uint32_t j=0; j < lCounterNodesNumber; ++j) {
+      uint32_t lDecWidth = lCounterValueColumnWidths.at(j).first;
+      uint32_t lHexWidth = lCounterValueColumnWidths.at(j).second;
+
+      std::string lDecValue = lCounterValueContainers.at(j).at(i).first;
+      std::string lHexValue = lCounterValueContainers.at(j).at(i).second;
+
+      lTableRowStream << boost::format(" %=s | %=s |") % boost::io::group(std::setw(lDecWidth), lDecValue) % boost::io::group(std::setw(lHexWidth), lHexValue);
+
+    }
+    lTableStream << lTableRowStream.str() << std::endl;
+  }
+
+  lTableStream << lRowBorder.str();
+
+  return lTableStream.str();
+}
+
+} // namespace legacy
+
+namespace {
+
+/**
+ * @brief      Average time of one call of a table renderer, in microseconds.
+ */
+template<typename F>
+double time_per_call(uint32_t iterations, F render) {
+  size_t lSink = 0;
+  auto lStart = std::chrono::steady_clock::now();
+  for (uint32_t i=0; i < iterations; ++i) lSink += render().size();
+  auto lElapsed = std::chrono::steady_clock::now() - lStart;
+  // Keeps the calls from being optimised away
+  if (!lSink) std::cout << "";
+  return std::chrono::duration<double, std::micro>(lElapsed).count() / iterations;
+}
+
+/**
+ * @brief      Time both renderers of a table and check that they agree.
+ */
+template<typename F, typename G>
+bool compare(const std::string& name, uint32_t iterations, F legacy_render, G render) {
+  if (legacy_render() != render()) {
+    std::cout << name << ": tables differ" << std::endl;
+    std::cout << legacy_render() << std::endl << render() << std::endl;
+    return false;
+  }
+
+  double lLegacyTime = time_per_call(iterations, legacy_render);
+  double lTime = time_per_call(iterations, render);
+  std::cout << name << ": " << lLegacyTime << " us -> " << lTime << " us, x" << lLegacyTime / lTime << std::endl;
+  return true;
+}
+
+} // namespace
+
+// ----------------------------------------------------------
+int main(int argc, char const *argv[])
+{
+  const uint32_t lIterations = argc > 1 ? std::strtoul(argv[1], nullptr, 0) : 200;
+
+  std::mt19937 lRandom(20201019);
+  auto lRandomValue = [&]() {
+    // Mixed magnitudes, zero included, so that the column widths vary
+    uint32_t lValue = lRandom();
+    return lValue >> (lRandom() % 33 == 32 ? 31 : lRandom() % 32) >> (lRandom() % 2);
+  };
+
+  // Register tables: a status table and a 2048 row endpoint buffer dump
+  std::vector<std::pair<std::string, uint32_t>> lStatus;
+  for (uint32_t i=0; i < 16; ++i) lStatus.push_back(std::make_pair("csr.stat.field" + std::to_string(i), lRandomValue()));
+
+  std::vector<std::pair<std::string, uint32_t>> lBuffer;
+  for (uint32_t i=0; i < 2048; ++i) lBuffer.push_back(std::make_pair(std::to_string(i), lRandomValue()));
+
+  // Counter tables: the accepted and rejected counters of a partition
+  std::vector<std::string> lLabels;
+  for (auto& lCommand : g_command_map) lLabels.push_back(lCommand.second);
+
+  std::vector<std::vector<uint32_t>> lCounters(2);
+  for (auto& lCounterBlock : lCounters) {
+    for (uint32_t i=0; i < lLabels.size(); ++i) lCounterBlock.push_back(lRandomValue());
+  }
+  const std::vector<std::string> lTitles = {"Accept counters", "Reject counters"};
+
+  bool lSuccess = true;
+  lSuccess &= compare("format_reg_table, 16 rows", lIterations,
+    [&]() { return legacy::format_reg_table(lStatus, "Status", {"Register", "Value"}); },
+    [&]() { return format_reg_table(lStatus, "Status", {"Register", "Value"}); });
+  lSuccess &= compare("format_reg_table, 2048 rows", lIterations,
+    [&]() { return legacy::format_reg_table(lBuffer, "Buffer", {"Word", "Data"}); },
+    [&]() { return format_reg_table(lBuffer, "Buffer", {"Word", "Data"}); });
+  lSuccess &= compare("format_counters_table", lIterations,
+    [&]() { return legacy::format_counters_table(lCounters, lTitles, "Partition counters", lLabels, "Cmd"); },
+    [&]() { return format_counters_table(lCounters, lTitles, "Partition counters", lLabels, "Cmd"); });
+
+  return lSuccess ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file BinaryCodec_test.cxx
+ *
+ * Round trips of the monitoring records through the binary codec.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/BinaryCodec.hpp"
+#include "timing/timingfirmwareinfo/Codec.hpp"
+#include "timing/timinghardwareinfo/Codec.hpp"
+
+#define BOOST_TEST_MODULE BinaryCodec_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace dunedaq::timing;
+
+BOOST_AUTO_TEST_SUITE(BinaryCodec_test)
+
+namespace {
+
+timingfirmwareinfo::TimingPDIMasterMonitorData
+make_master_data() {
+    timingfirmwareinfo::TimingPDIMasterMonitorData lData;
+    lData.class_name = "PDIMasterNode";
+    lData.timestamp = 0x0123456789abcdefull;
+    lData.spill_interface_enabled = true;
+    lData.trig_interface_enabled = false;
+
+    for (uint32_t i=0; i < 3; ++i) {
+        timingfirmwareinfo::TimingFLCmdCounters lCounters;
+        lCounters.accepted = 100 + i;
+        lCounters.rejected = 0xffffffff - i;
+        lData.command_counters.push_back(lCounters);
+    }
+    for (uint32_t i=0; i < 4; ++i) {
+        timingfirmwareinfo::TimingPartitionMonitorData lPartition;
+        lPartition.enabled = (i % 2 == 0);
+        lPartition.in_run = (i == 1);
+        lPartition.trig_mask = 0xf0 + i;
+        lPartition.buffer_occupancy = 1000 * i;
+        lData.partitions_data.push_back(lPartition);
+    }
+    return lData;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(RecordStartsWithSchemaHash)
+{
+    const std::string lBuffer = binary_codec::encode_record(make_master_data());
+
+    binary_codec::Reader lReader(lBuffer.data(), lBuffer.size());
+    BOOST_REQUIRE_EQUAL(lReader.get<uint64_t>(), binary_codec::schema_hash<timingfirmwareinfo::TimingPDIMasterMonitorData>());
+    BOOST_REQUIRE_NE(binary_codec::schema_hash<timingfirmwareinfo::TimingPDIMasterMonitorData>(),
+                     binary_codec::schema_hash<timingfirmwareinfo::TimingPartitionMonitorData>());
+}
+
+BOOST_AUTO_TEST_CASE(MasterDataRoundTrip)
+{
+    const auto lData = make_master_data();
+    const auto lDecoded = binary_codec::decode_record<timingfirmwareinfo::TimingPDIMasterMonitorData>(binary_codec::encode_record(lData));
+
+    BOOST_REQUIRE_EQUAL(lDecoded.class_name, lData.class_name);
+    BOOST_REQUIRE_EQUAL(lDecoded.timestamp, lData.timestamp);
+    BOOST_REQUIRE_EQUAL(lDecoded.spill_interface_enabled, lData.spill_interface_enabled);
+    BOOST_REQUIRE_EQUAL(lDecoded.trig_interface_enabled, lData.trig_interface_enabled);
+
+    BOOST_REQUIRE_EQUAL(lDecoded.command_counters.size(), lData.command_counters.size());
+    for (uint32_t i=0; i < lData.command_counters.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(lDecoded.command_counters.at(i).accepted, lData.command_counters.at(i).accepted);
+        BOOST_REQUIRE_EQUAL(lDecoded.command_counters.at(i).rejected, lData.command_counters.at(i).rejected);
+    }
+
+    BOOST_REQUIRE_EQUAL(lDecoded.partitions_data.size(), lData.partitions_data.size());
+    for (uint32_t i=0; i < lData.partitions_data.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(lDecoded.partitions_data.at(i).enabled, lData.partitions_data.at(i).enabled);
+        BOOST_REQUIRE_EQUAL(lDecoded.partitions_data.at(i).in_run, lData.partitions_data.at(i).in_run);
+        BOOST_REQUIRE_EQUAL(lDecoded.partitions_data.at(i).trig_mask, lData.partitions_data.at(i).trig_mask);
+        BOOST_REQUIRE_EQUAL(lDecoded.partitions_data.at(i).buffer_occupancy, lData.partitions_data.at(i).buffer_occupancy);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CounterRatesRoundTrip)
+{
+    timingfirmwareinfo::TimingCounterRates lRates;
+    lRates.name = "master.partition0.accepted";
+    lRates.labels = {"TimeSync", "Echo", "SpillStart"};
+    lRates.totals = {1, 0x100000002ull, 3};
+    lRates.rates = {0.5, 1e6, 0.};
+    lRates.window = 10.;
+
+    timingfirmwareinfo::TimingCounterRatesVector lData = {lRates, lRates};
+    const auto lDecoded = binary_codec::decode_record<timingfirmwareinfo::TimingCounterRatesVector>(binary_codec::encode_record(lData));
+
+    BOOST_REQUIRE_EQUAL(lDecoded.size(), 2);
+    BOOST_REQUIRE_EQUAL(lDecoded.at(1).name, lRates.name);
+    BOOST_REQUIRE(lDecoded.at(1).labels == lRates.labels);
+    BOOST_REQUIRE(lDecoded.at(1).totals == lRates.totals);
+    BOOST_REQUIRE(lDecoded.at(1).rates == lRates.rates);
+    BOOST_REQUIRE_EQUAL(lDecoded.at(1).window, lRates.window);
+}
+
+BOOST_AUTO_TEST_CASE(ConsecutiveRecords)
+{
+    timinghardwareinfo::TimingFMCMonitorData lData;
+    timinghardwareinfo::TimingFMCMonitorDataDebug lDebugData;
+    lData.class_name = "FMCIONode";
+    lDebugData.class_name = "FMCIONode";
+
+    std::string lBuffer;
+    binary_codec::Writer lWriter(lBuffer);
+    binary_codec::encode_record(lWriter, lData);
+    binary_codec::encode_record(lWriter, lDebugData);
+
+    binary_codec::Reader lReader(lBuffer.data(), lBuffer.size());
+    BOOST_REQUIRE_EQUAL(binary_codec::decode_record<timinghardwareinfo::TimingFMCMonitorData>(lReader).class_name, lData.class_name);
+    BOOST_REQUIRE_EQUAL(binary_codec::decode_record<timinghardwareinfo::TimingFMCMonitorDataDebug>(lReader).class_name, lDebugData.class_name);
+    BOOST_REQUIRE_EQUAL(lReader.remaining(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SchemaMismatch)
+{
+    const std::string lBuffer = binary_codec::encode_record(make_master_data());
+    BOOST_REQUIRE_THROW(binary_codec::decode_record<timingfirmwareinfo::TimingPartitionMonitorData>(lBuffer), BinaryCodecSchemaMismatch);
+}
+
+BOOST_AUTO_TEST_CASE(CorruptBuffers)
+{
+    const std::string lBuffer = binary_codec::encode_record(make_master_data());
+    BOOST_REQUIRE_THROW(binary_codec::decode_record<timingfirmwareinfo::TimingPDIMasterMonitorData>(lBuffer.substr(0, lBuffer.size() - 1)), BinaryCodecError);
+    BOOST_REQUIRE_THROW(binary_codec::decode_record<timingfirmwareinfo::TimingPDIMasterMonitorData>(lBuffer + '\0'), BinaryCodecError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+/**
+ * @file CounterRates_test.cxx
+ *
+ * Accumulation of the 32 bit firmware counters into totals and rates,
+ * across wraparounds and counter resets. The CounterRateEngine cases run
+ * against the ouroboros-sim board served over UDP on localhost.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/CounterRateEngine.hpp"
+#include "timing/MonitoringHistory.hpp"
+#include "timing/toolbox.hpp"
+
+#define BOOST_TEST_MODULE CounterRates_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include "SimulatorFixture.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace dunedaq::timing;
+
+BOOST_AUTO_TEST_SUITE(CounterRates_test)
+
+BOOST_AUTO_TEST_CASE(CounterIncrease)
+{
+    const std::chrono::seconds kOneSecond(1);
+
+    BOOST_CHECK_EQUAL(counter_increase(100, 150, kOneSecond), 50u);
+    BOOST_CHECK_EQUAL(counter_increase(100, 100, kOneSecond), 0u);
+
+    // A drop from near 2^32 that fits the elapsed time is a wrap
+    BOOST_CHECK_EQUAL(counter_increase(0xffffff00, 0x10, kOneSecond), 0x110u);
+
+    // Any other drop is a reset: only the new value is counted
+    BOOST_CHECK_EQUAL(counter_increase(5000, 12, kOneSecond), 12u);
+    BOOST_CHECK_EQUAL(counter_increase(0x80000000, 0x10, kOneSecond), 0x10u);
+    BOOST_CHECK_EQUAL(counter_increase(0xffffff00, 0x10, std::chrono::nanoseconds(1)), 0x10u);
+    BOOST_CHECK_EQUAL(counter_increase(0x100000000ull, 7, kOneSecond), 7u);
+}
+
+BOOST_AUTO_TEST_CASE(HistoryRateAcrossReset)
+{
+    MonitoringHistory lHistory;
+    const auto lStart = std::chrono::system_clock::now();
+
+    // 100 counts per second, reset after the third second
+    const std::vector<uint32_t> lValues = {0, 100, 200, 300, 50, 150, 250};
+    for (uint32_t i=0; i < lValues.size(); ++i) {
+        lHistory.record_counters("ep", {lValues.at(i)}, lStart + std::chrono::seconds(i));
+    }
+
+    double lRate = lHistory.rate("ep.0", lStart, lStart + std::chrono::seconds(6));
+    BOOST_CHECK_CLOSE(lRate, 550. / 6., 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(HistoryRateAcrossWrap)
+{
+    MonitoringHistory lHistory;
+    const auto lStart = std::chrono::system_clock::now();
+
+    lHistory.record_counters("ep", {0xffffff00}, lStart);
+    lHistory.record_counters("ep", {0x100}, lStart + std::chrono::seconds(1));
+
+    BOOST_CHECK_CLOSE(lHistory.rate("ep.0", lStart, lStart + std::chrono::seconds(1)), 512., 1e-6);
+}
+
+BOOST_FIXTURE_TEST_CASE(EngineTotalsAcrossReset, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const EndpointNode& lEndpoint = endpoint(0);
+    lEndpoint.enable(0, 0);
+    master().enable_fake_trigger(0, 1000.);
+
+    CounterRateEngine lEngine;
+    lEngine.add_endpoint("endpoint0", lEndpoint);
+
+    lEngine.sample();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    lEngine.sample();
+    const uint64_t lBeforeReset = lEngine.get_rates("endpoint0").totals.at(0x8);
+    BOOST_CHECK_GT(lBeforeReset, 0u);
+
+    // enable pulses ctr_rst, clearing the counters in the middle of the run
+    lEndpoint.enable(0, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    lEngine.sample();
+
+    auto lRates = lEngine.get_rates("endpoint0");
+    const uint64_t lAfterReset = lRates.totals.at(0x8);
+    BOOST_CHECK_GE(lAfterReset, lBeforeReset);
+    BOOST_CHECK_LT(lAfterReset, lBeforeReset + 10000);
+    BOOST_CHECK_LT(lRates.rates.at(0x8), 10000.);
+
+    master().disable_fake_trigger(0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
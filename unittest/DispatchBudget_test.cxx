@@ -0,0 +1,316 @@
+/**
+ * @file DispatchBudget_test.cxx
+ *
+ * Number of IPbus dispatches, transactions and bytes issued by the high
+ * level operations, run against the ouroboros-sim board served over UDP
+ * on localhost. The PLL upload runs against the emulated I2C bus of the
+ * simulator. The cases are skipped when TIMING_SHARE is not set.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/CounterRateEngine.hpp"
+#include "timing/DispatchAccounting.hpp"
+#include "timing/EndpointNode.hpp"
+#include "timing/MonitoringHistory.hpp"
+#include "timing/PDIMasterNode.hpp"
+#include "timing/PartitionBufferPoller.hpp"
+#include "timing/PartitionNode.hpp"
+#include "timing/SI534xNode.hpp"
+#include "timing/VLCmdGeneratorNode.hpp"
+#include "timing/definitions.hpp"
+#include "timing/toolbox.hpp"
+
+#define BOOST_TEST_MODULE DispatchBudget_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include "SimulatorFixture.hpp"
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace dunedaq::timing;
+
+BOOST_AUTO_TEST_SUITE(DispatchBudget_test)
+
+namespace {
+
+/**
+ * @brief      Dispatches issued by an operation.
+ */
+template<typename F>
+uint64_t
+count_dispatches(F&& operation) {
+    DispatchScope lScope("DispatchBudget_test");
+    operation();
+    return lScope.get_dispatches();
+}
+
+struct Cost {
+    uint64_t dispatches;
+    uint64_t transactions;
+    uint64_t bytes;
+};
+
+/**
+ * @brief      Dispatches, transactions and bytes (requests and replies) of an operation.
+ */
+template<typename F>
+Cost
+measure(const SimulatorFixture& fixture, F&& operation) {
+    const uint64_t lTransactions = fixture.get_transactions();
+    const uint64_t lBytes = fixture.get_bytes();
+    const uint64_t lDispatches = count_dispatches(operation);
+    return {lDispatches, fixture.get_transactions() - lTransactions, fixture.get_bytes() - lBytes};
+}
+
+// I2C transfers: each byte costs a data write, a command and a status poll (a command,
+// a status poll and a data read when reading); a transfer opens with the bus reset
+const uint64_t kI2CWriteDispatches = 2 + 3 + 3 * 2;                  // register address and data
+const uint64_t kI2CReadDispatches = (2 + 3 + 3) + (2 + 3 + 3);        // register address, then the data
+
+// SI534x registers: the page is read before each access and written when it changes
+const uint64_t kPLLWriteDispatches = kI2CReadDispatches + kI2CWriteDispatches;
+const uint64_t kPLLReadDispatches = 2 * kI2CReadDispatches;
+const uint64_t kPLLPageDispatches = kI2CWriteDispatches;
+
+/**
+ * @brief      Simulator sending async commands as soon as go is written.
+ */
+struct InstantAsyncCommandFixture : public SimulatorFixture {
+    InstantAsyncCommandFixture() : SimulatorFixture({0x8000, std::chrono::microseconds(0), 100, 0, 0}) {}
+};
+
+std::vector<ActiveEndpointConfig>
+get_endpoint_delays() {
+    std::vector<ActiveEndpointConfig> lEndpoints;
+    for (uint32_t i=0; i < 3; ++i) {
+        lEndpoints.emplace_back("endpoint" + std::to_string(i), 0x10 + i);
+        lEndpoints.back().cdelay = i;
+    }
+    return lEndpoints;
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(EndpointOperations, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const EndpointNode& lEndpoint = endpoint(0);
+
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lEndpoint.enable(0, 0); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lEndpoint.reset(1, 0x20); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lEndpoint.read_timestamp(); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lEndpoint.read_command_counters(); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lEndpoint.get_status(); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lEndpoint.disable(); }), 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(EndpointTransactions, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const EndpointNode& lEndpoint = endpoint(0);
+
+    // Masked writes are read-modify-write transactions: 4 words out, 2 back
+    Cost lEnable = measure(*this, [&]() { lEndpoint.enable(0, 0); });
+    BOOST_CHECK_EQUAL(lEnable.transactions, 6u);
+    BOOST_CHECK_EQUAL(lEnable.bytes, (2 + 6 * (4 + 2)) * 4u);
+
+    // Block reads: 2 words out, the header and the block back, plus the packet headers
+    Cost lTimestamp = measure(*this, [&]() { lEndpoint.read_timestamp(); });
+    BOOST_CHECK_EQUAL(lTimestamp.transactions, 1u);
+    BOOST_CHECK_EQUAL(lTimestamp.bytes, (2 + 2 + 1 + 2) * 4u);
+
+    Cost lCounters = measure(*this, [&]() { lEndpoint.read_command_counters(); });
+    BOOST_CHECK_EQUAL(lCounters.transactions, 1u);
+    BOOST_CHECK_EQUAL(lCounters.bytes, (2 + 2 + 1 + g_command_number) * 4u);
+}
+
+BOOST_FIXTURE_TEST_CASE(PartitionOperations, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const PartitionNode& lPartition = partition(0);
+
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPartition.reset(); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPartition.enable(true); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPartition.configure(0xff, false); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPartition.read_buffer_status(); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPartition.read_command_counts(); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPartition.get_status(); }), 1u);
+
+    // Nothing to read, nothing to dispatch
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPartition.read_buffer_data(0); }), 0u);
+
+    // One transaction per register field or block
+    BOOST_CHECK_EQUAL(measure(*this, [&]() { lPartition.configure(0xff, false); }).transactions, 3u);
+    BOOST_CHECK_EQUAL(measure(*this, [&]() { lPartition.read_buffer_status(); }).transactions, 3u);
+    BOOST_CHECK_EQUAL(measure(*this, [&]() { lPartition.read_command_counts(); }).transactions, 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(RunControl, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const PDIMasterNode& lMaster = master();
+    const PartitionNode& lPartition = partition(0);
+
+    // The simulator changes run state at once: one dispatch to request, one poll to see it
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPartition.enable(true); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPartition.start(); }), 2u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPartition.stop(); }), 2u);
+
+    // Partitions of a board are handled in the same dispatches
+    const std::vector<uint32_t> lIds = {0, 1, 2, 3};
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lMaster.configure_partitions(lIds, 0xff, false); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lMaster.start_partitions(lIds); }), 2u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lMaster.stop_partitions(lIds); }), 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(ReadEvents, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const PDIMasterNode& lMaster = master();
+    const PartitionNode& lPartition = partition(0);
+
+    lPartition.enable(true);
+    lPartition.configure(0x1, false, false);
+    lPartition.start();
+    lPartition.enable_triggers(true);
+    lMaster.enable_fake_trigger(0, 1000.);
+
+    BOOST_REQUIRE(poll_until([&]() { return lPartition.num_events_in_buffer() >= 2; }, std::chrono::seconds(5)).success);
+
+    // Occupancy and data
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPartition.read_events(1); }), 2u);
+
+    PartitionBufferPoller lPoller(lPartition);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPoller.poll(); }), 2u);
+
+    // An empty buffer only costs the occupancy read
+    lPartition.enable_triggers(false);
+    lPoller.poll();
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPoller.poll(); }), 1u);
+
+    lMaster.disable_fake_trigger(0);
+    lPartition.stop();
+}
+
+BOOST_FIXTURE_TEST_CASE(CounterRateSample, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    CounterRateEngine lEngine;
+    for (uint32_t i=0; i < PDIMasterNode::kNumberOfPartitions; ++i) {
+        lEngine.add_partition("partition" + std::to_string(i), partition(i));
+    }
+    for (uint32_t i=0; i < 4; ++i) {
+        lEngine.add_endpoint("endpoint" + std::to_string(i), endpoint(i));
+    }
+
+    // All the counters of a board are read in one dispatch
+    MonitoringHistory lHistory;
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lEngine.sample(); }), 1u);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lEngine.sample(&lHistory); }), 1u);
+
+    // Accepted and rejected blocks of the partitions, one block per endpoint
+    BOOST_CHECK_EQUAL(measure(*this, [&]() { lEngine.sample(); }).transactions, 2u * PDIMasterNode::kNumberOfPartitions + 4);
+}
+
+BOOST_FIXTURE_TEST_CASE(EndpointRTT, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const uint32_t kEchoes = 4;
+
+    // Upstream endpoint reset (2) and lock poll (1), then per echo the request and a single poll:
+    // the simulator answers at once and the timestamps are read along with the done flag
+    RTTStatistics lRTT;
+    Cost lCost = measure(*this, [&]() { lRTT = master().measure_endpoint_rtt_statistics(0, kEchoes, false); });
+    BOOST_CHECK_EQUAL(lCost.dispatches, 3u + 2 * kEchoes);
+    BOOST_CHECK_EQUAL(lCost.transactions, 4u + 6 * kEchoes);
+    BOOST_CHECK_EQUAL(lRTT.samples, kEchoes);
+    BOOST_CHECK_EQUAL(lRTT.median, 100u);
+}
+
+BOOST_FIXTURE_TEST_CASE(EndpointDelays, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const VLCmdGeneratorNode& lAcmd = master().getNode<VLCmdGeneratorNode>("master.acmd");
+    const auto lEndpoints = get_endpoint_delays();
+
+    // The command goes out with done read back low, then one poll sees it sent
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lAcmd.apply_endpoint_delays(lEndpoints); }), 2u * lEndpoints.size());
+}
+
+BOOST_FIXTURE_TEST_CASE(EndpointDelaysSentAtOnce, InstantAsyncCommandFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const VLCmdGeneratorNode& lAcmd = master().getNode<VLCmdGeneratorNode>("master.acmd");
+    const auto lEndpoints = get_endpoint_delays();
+
+    // done is already high in the packet carrying go: the commands are complete, not timed out
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lAcmd.apply_endpoint_delays(lEndpoints); }), lEndpoints.size());
+}
+
+BOOST_FIXTURE_TEST_CASE(PLLRegisterAccess, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const SI534xNode& lPLL = pll();
+
+    // The first transfer also programs the I2C prescaler
+    lPLL.read_page();
+
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPLL.write_clock_register(0x0b, 0x68); }), kPLLWriteDispatches);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPLL.read_clock_register(0x0b); }), kPLLReadDispatches);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPLL.write_clock_register(0x26b, 0x70); }), kPLLWriteDispatches + kPLLPageDispatches);
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPLL.read_clock_register(0x26b); }), kPLLReadDispatches);
+
+    BOOST_CHECK_EQUAL(static_cast<uint32_t>(lPLL.read_clock_register(0x26b)), 0x70u);
+    BOOST_CHECK_EQUAL(static_cast<uint32_t>(lPLL.read_clock_register(0x0b)), 0x68u);
+}
+
+BOOST_FIXTURE_TEST_CASE(PLLUpload, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const SI534xNode& lPLL = pll();
+    const std::string lConfig = std::string(std::getenv("TIMING_SHARE")) + "/config/etc/clock/SI5345/PDTS0004.txt";
+
+    // The soft reset, then every register of the file, then the design ID readback
+    std::vector<uint16_t> lWrites = {0x1e};
+    std::ifstream lFile(lConfig);
+    BOOST_REQUIRE(lFile.good());
+    for (std::string lLine; std::getline(lFile, lLine);) {
+        if (boost::starts_with(lLine, "0x")) lWrites.push_back(static_cast<uint16_t>(std::stoul(lLine.substr(0, lLine.find(',')), nullptr, 16)));
+    }
+
+    uint16_t lPage = 0x0;
+    auto lPageDispatches = [&lPage](uint16_t address) {
+        bool lChange = (address >> 8) != lPage;
+        lPage = address >> 8;
+        return lChange ? kPLLPageDispatches : 0;
+    };
+
+    uint64_t lBudget = 0;
+    for (auto lAddress : lWrites) lBudget += kPLLWriteDispatches + lPageDispatches(lAddress);
+    for (uint16_t i=0; i < 8; ++i) lBudget += kPLLReadDispatches + lPageDispatches(0x26b + i);
+
+    lPLL.read_page();
+
+    // configure throws if the design ID read back does not match the file
+    BOOST_CHECK_EQUAL(count_dispatches([&]() { lPLL.configure(lConfig); }), lBudget);
+}
+
+BOOST_FIXTURE_TEST_CASE(StatsByOperation, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    reset_dispatch_stats();
+
+    partition(0).get_status();
+    partition(1).get_status();
+    endpoint(0).get_status();
+
+    DispatchStats lPartitionStats = get_dispatch_stats("PartitionNode::get_status");
+    BOOST_CHECK_EQUAL(lPartitionStats.calls, 2u);
+    BOOST_CHECK_EQUAL(lPartitionStats.dispatches, 2u);
+    BOOST_CHECK_EQUAL(lPartitionStats.max_dispatches, 1u);
+
+    DispatchStats lEndpointStats = get_dispatch_stats("EndpointNode::get_status");
+    BOOST_CHECK_EQUAL(lEndpointStats.calls, 1u);
+    BOOST_CHECK_EQUAL(lEndpointStats.max_dispatches, 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
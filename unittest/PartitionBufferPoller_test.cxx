@@ -0,0 +1,77 @@
+/**
+ * @file PartitionBufferPoller_test.cxx
+ *
+ * Occupancy accounting of the partition buffer poller, with more words
+ * in the buffer than the data port delivers in a block. Runs against the
+ * ouroboros-sim board served over UDP on localhost.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "timing/PartitionBufferPoller.hpp"
+#include "timing/PartitionNode.hpp"
+#include "timing/toolbox.hpp"
+
+#define BOOST_TEST_MODULE PartitionBufferPoller_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include "SimulatorFixture.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+using namespace dunedaq::timing;
+
+BOOST_AUTO_TEST_SUITE(PartitionBufferPoller_test)
+
+BOOST_FIXTURE_TEST_CASE(CapacityIsTheFifoDepth, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    // The depth declared in the address table, not the size of the data port
+    BOOST_CHECK_EQUAL(partition(0).get_buffer_capacity(), 0x8000u);
+    BOOST_CHECK_EQUAL(partition(0).get_buffer_read_size(), 0x400u);
+}
+
+BOOST_FIXTURE_TEST_CASE(OccupancyAboveTheDataPort, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable()))
+{
+    const PartitionNode& lPartition = partition(0);
+    const uint32_t kReadSize = 0x400 - (0x400 % PartitionNode::kWordsPerEvent);
+
+    lPartition.enable(true);
+    lPartition.configure(0x1, false, false);
+    lPartition.start();
+    lPartition.enable_triggers(true);
+    master().enable_fake_trigger(0, 50000.);
+
+    BOOST_REQUIRE(poll_until([&]() { return lPartition.read_buffer_word_count() >= 0x600; }, std::chrono::seconds(5)).success);
+    lPartition.enable_triggers(false);
+    master().disable_fake_trigger(0);
+
+    const uint32_t lWords = lPartition.read_buffer_word_count();
+    BOOST_REQUIRE_GT(lWords, 0x400u);
+
+    PartitionBufferPoller lPoller(lPartition);
+
+    // A poll drains at most one data port block
+    auto lEvents = lPoller.poll();
+    BOOST_CHECK_EQUAL(lEvents.size(), kReadSize);
+    BOOST_CHECK_EQUAL(lPoller.get_stats().peak_word_count, lWords);
+    BOOST_CHECK_CLOSE(lPoller.get_stats().peak_occupancy, static_cast<double>(lWords) / 0x8000, 1e-6);
+    BOOST_CHECK_LT(lPoller.get_stats().peak_occupancy, 1.);
+
+    // The backlog is left for the next polls
+    BOOST_CHECK_EQUAL(lPartition.read_buffer_word_count(), lWords - kReadSize);
+    uint64_t lEventsRead = lPoller.get_stats().events_read;
+    while (lPartition.read_buffer_word_count() >= PartitionNode::kWordsPerEvent) {
+        lPoller.poll();
+        BOOST_REQUIRE_GT(lPoller.get_stats().events_read, lEventsRead);
+        lEventsRead = lPoller.get_stats().events_read;
+    }
+    BOOST_CHECK_EQUAL(lEventsRead, lWords / PartitionNode::kWordsPerEvent);
+
+    lPartition.stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,149 @@
+/**
+ * @file SimulatorFixture.hpp
+ *
+ * Boost.Test fixture serving a SimulatedBoard over IPbus UDP on localhost,
+ * for the unit tests that exercise the library against a timing board.
+ *
+ * This is part of the DUNE DAQ Software Suite, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef TIMING_UNITTEST_SIMULATORFIXTURE_HPP_
+#define TIMING_UNITTEST_SIMULATORFIXTURE_HPP_
+
+#include "timing/EndpointNode.hpp"
+#include "timing/PDIMasterNode.hpp"
+#include "timing/PartitionNode.hpp"
+#include "timing/SI534xNode.hpp"
+#include "timing/SimulatedBoard.hpp"
+#include "timing/SimulatedIPbusTarget.hpp"
+
+#include "uhal/ConnectionManager.hpp"
+#include "uhal/log/log.hpp"
+
+#include "boost/test/unit_test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <string.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+namespace dunedaq {
+namespace timing {
+
+/**
+ * @brief      Precondition of the simulator test cases: they are skipped when the address tables cannot be found.
+ *
+ *             Use as BOOST_FIXTURE_TEST_CASE(Name, SimulatorFixture, *boost::unit_test::precondition(SimulatorAvailable())).
+ */
+struct SimulatorAvailable {
+    boost::test_tools::assertion_result operator()(boost::unit_test::test_unit_id) const {
+        boost::test_tools::assertion_result lResult(std::getenv("TIMING_SHARE") != nullptr);
+        lResult.message() << "TIMING_SHARE is not set";
+        return lResult;
+    }
+};
+
+/**
+ * @brief      A fresh simulated board, served on an ephemeral localhost port for the lifetime of the fixture.
+ */
+class SimulatorFixture {
+
+public:
+    explicit SimulatorFixture(const SimulatedBoardConfig& config={0x8000, std::chrono::microseconds(0), 100, 0}) :
+        m_socket(-1),
+        m_stop(false) {
+        const char* lShare = std::getenv("TIMING_SHARE");
+        BOOST_REQUIRE_MESSAGE(lShare, "TIMING_SHARE is not set");
+
+        m_socket = ::socket(AF_INET, SOCK_DGRAM, 0);
+        BOOST_REQUIRE(m_socket >= 0);
+
+        sockaddr_in lAddress;
+        socklen_t lAddressSize = sizeof(lAddress);
+        memset(&lAddress, 0, sizeof(lAddress));
+        lAddress.sin_family = AF_INET;
+        lAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        BOOST_REQUIRE(::bind(m_socket, reinterpret_cast<sockaddr*>(&lAddress), sizeof(lAddress)) == 0);
+        BOOST_REQUIRE(::getsockname(m_socket, reinterpret_cast<sockaddr*>(&lAddress), &lAddressSize) == 0);
+
+        uhal::setLogLevelTo(uhal::WarningLevel());
+        m_hw.reset(new uhal::HwInterface(uhal::ConnectionManager::getDevice("SIM_TEST",
+            "ipbusudp-2.0://127.0.0.1:" + std::to_string(ntohs(lAddress.sin_port)),
+            "file://" + std::string(lShare) + "/config/etc/addrtab/v5a2/ouroboros_sim/top_sim.xml")));
+
+        m_board.reset(new SimulatedBoard(m_hw->getNode(), config));
+        m_target.reset(new SimulatedIPbusTarget(*m_board));
+        m_server = std::thread(&SimulatorFixture::serve, this);
+
+        // The first dispatch may open with a status packet; keep it out of the tests' counts
+        m_hw->getNode("io.config").read();
+        m_hw->dispatch();
+    }
+
+    ~SimulatorFixture() {
+        m_stop = true;
+        if (m_server.joinable()) m_server.join();
+        if (m_socket >= 0) ::close(m_socket);
+    }
+
+    const PDIMasterNode& master() const { return m_hw->getNode<PDIMasterNode>("master_top"); }
+    const PartitionNode& partition(uint32_t id) const { return master().get_partition_node(id); }
+    const EndpointNode& endpoint(uint32_t id) const { return m_hw->getNode<EndpointNode>("endpoint" + std::to_string(id)); }
+    const SI534xNode& pll() const { return m_hw->getNode<SI534xNode>("io.pll_i2c"); }
+
+    /**
+     * @brief      Transactions and bytes served so far.
+     */
+    uint64_t get_transactions() const { return m_target->get_transactions(); }
+    uint64_t get_bytes() const { return m_target->get_bytes(); }
+
+private:
+    void serve() {
+        std::vector<uint32_t> lRequest(0x4000);
+        std::vector<uint32_t> lReply;
+
+        while (!m_stop) {
+            pollfd lPoll = {m_socket, POLLIN, 0};
+            if (::poll(&lPoll, 1, 20) <= 0) {
+                m_board->advance();
+                continue;
+            }
+
+            sockaddr_in lPeer;
+            socklen_t lPeerSize = sizeof(lPeer);
+            ssize_t lBytes = ::recvfrom(m_socket, lRequest.data(), lRequest.size() * sizeof(uint32_t), 0, reinterpret_cast<sockaddr*>(&lPeer), &lPeerSize);
+            if (lBytes <= 0) continue;
+
+            std::vector<uint32_t> lWords(lRequest.begin(), lRequest.begin() + lBytes / sizeof(uint32_t));
+            if (m_target->handle(lWords, lReply)) {
+                ::sendto(m_socket, lReply.data(), lReply.size() * sizeof(uint32_t), 0, reinterpret_cast<sockaddr*>(&lPeer), lPeerSize);
+            }
+        }
+    }
+
+    int m_socket;
+    std::atomic<bool> m_stop;
+    std::unique_ptr<uhal::HwInterface> m_hw;
+    std::unique_ptr<SimulatedBoard> m_board;
+    std::unique_ptr<SimulatedIPbusTarget> m_target;
+    std::thread m_server;
+};
+
+} // namespace timing
+} // namespace dunedaq
+
+#endif // TIMING_UNITTEST_SIMULATORFIXTURE_HPP_